@@ -31,13 +31,13 @@ typed_error<LibA::eFOO> LibA::get_foo(const char *message) {
 }
 
 void LibA::foo_me(const char *message) {
-  throw typed_error<LibA::eFOO>(message);
+  raise_typed<LibA::eFOO>(message);
 }
 
 void LibA::bar_me(const char *message) {
-  throw typed_error<LibA::eBAR>(message);
+  raise_typed<LibA::eBAR>(message);
 }
 
 void LibA::suprise_me(const char *message) {
-  throw typed_error<LibA::ePOR>(message);
+  raise_typed<LibA::ePOR>(message);
 }
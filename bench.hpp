@@ -0,0 +1,42 @@
+/*
+ * bench.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef BENCH_HPP_
+#define BENCH_HPP_
+
+#include <chrono>
+#include <cstdio>
+
+// minimal timing support for the bench_* programs - these are not tests,
+// they report ns/op so the cost of each approach can be compared
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+// results are accumulated here so the optimiser cannot discard the work
+extern volatile long bench_sink;
+
+// runs fn(i) for i in [0, iterations) and returns the mean ns per call
+template <typename F> double bench_ns(F fn, long iterations) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+inline void bench_report(const char *name, double ns) {
+  std::printf("%-48s %10.2f ns/op\n", name, ns);
+}
+
+#define BENCH_SINK_DEFINITION volatile long bench_sink = 0;
+
+#endif /* BENCH_HPP_ */
@@ -0,0 +1,78 @@
+/*
+ * bench_boundary.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+struct N {
+  static error_id internal;
+};
+
+const char N::internal[] = SCOPE_ERROR("GRP", "API", "internal error");
+
+BENCH_NOINLINE long work(long i) { return i * 3 + 1; }
+
+BENCH_NOINLINE long work_or_throw(long i, long fail_every) {
+  if (i % fail_every == 0) {
+    raise_typed<FooErrors::eFOO>();
+  }
+  return i * 3 + 1;
+}
+}
+
+int main() {
+  const long iterations = 50000000;
+
+  bench_report("direct call", bench_ns([](long i) { bench_sink += work(i); },
+                                       iterations));
+
+  bench_report("error_boundary, never throws",
+               bench_ns([](long i) {
+                 error_value err = error_boundary<N::internal>([i] { bench_sink += work(i); });
+                 if (err) {
+                   bench_sink += 1;
+                 }
+               },
+                        iterations));
+
+  bench_report("hand-written try/catch, never throws",
+               bench_ns([](long i) {
+                 try {
+                   bench_sink += work(i);
+                 } catch (const typed_error_base &e) {
+                   bench_sink += 1;
+                 }
+               },
+                        iterations));
+
+  const long failing = 1000000;
+
+  bench_report("error_boundary, throws every call",
+               bench_ns([](long i) {
+                 error_value err = error_boundary<N::internal>([i] { bench_sink += work_or_throw(i, 1); });
+                 if (err) {
+                   bench_sink += 1;
+                 }
+               },
+                        failing));
+
+  bench_report("error_boundary, throws every 1000th call",
+               bench_ns([](long i) {
+                 error_value err = error_boundary<N::internal>([i] { bench_sink += work_or_throw(i, 1000); });
+                 if (err) {
+                   bench_sink += 1;
+                 }
+               },
+                        failing));
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * bench_channel.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// senders reporting failures to one supervisor: error_channel against a
+// mutex protected std::vector<std::string> the supervisor swaps out
+// reports the ns per message from the first send to the last receive
+//
+// usage: bench_channel [senders]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "error_channel.hpp"
+#include "error_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+
+const unsigned each = 200000;
+
+double locked_vector(unsigned senders) {
+  std::mutex lock;
+  std::vector<std::string> reports;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < senders; ++t) {
+    threads.push_back(std::thread([&]() {
+      for (unsigned i = 0; i < each; ++i) {
+        std::lock_guard<std::mutex> hold(lock);
+        reports.push_back(std::string(FooErrors::eBAR) + " table orders");
+      }
+    }));
+  }
+  std::vector<std::string> batch;
+  for (unsigned long received = 0; received < static_cast<unsigned long>(senders) * each;) {
+    {
+      std::lock_guard<std::mutex> hold(lock);
+      batch.swap(reports);
+    }
+    received += batch.size();
+    bench_sink += batch.size();
+    batch.clear();
+    if (!received) {
+      std::this_thread::yield();
+    }
+  }
+  for (unsigned t = 0; t < senders; ++t) {
+    threads[t].join();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (senders * each);
+}
+
+double channel(unsigned senders) {
+  error_channel channel(4096);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < senders; ++t) {
+    threads.push_back(std::thread([&]() {
+      for (unsigned i = 0; i < each; ++i) {
+        while (!channel.try_send(FooErrors::eBAR, "table orders")) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+  error_message batch[256];
+  for (unsigned long received = 0; received < static_cast<unsigned long>(senders) * each;) {
+    size_t n = channel.receive(batch, 256);
+    received += n;
+    bench_sink += n;
+    if (!n) {
+      std::this_thread::yield();
+    }
+  }
+  for (unsigned t = 0; t < senders; ++t) {
+    threads[t].join();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (senders * each);
+}
+}
+
+int main(int argc, char *argv[]) {
+  unsigned senders = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    senders = std::atoi(argv[1]);
+  }
+  if (senders == 0) {
+    senders = 1;
+  }
+  std::printf("%u senders\n", senders);
+  bench_report("mutex + vector<string>, per message", locked_vector(senders));
+  bench_report("error_channel, per message", channel(senders));
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * bench_coroutine.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// a chain of four coroutines awaiting each other, the innermost failing or
+// not: error_task short-circuiting an error_value, against a conventional
+// lazy task whose promise keeps the exception_ptr and rethrows it in the
+// awaiting coroutine, level by level, with frames from the heap
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "error_result.hpp"
+#include "error_task.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+
+template <typename T> class throwing_task {
+public:
+  struct promise_type {
+    std::optional<T> value;
+    std::exception_ptr error;
+    std::coroutine_handle<> continuation;
+
+    throwing_task get_return_object() {
+      return throwing_task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    struct final_awaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> done) noexcept {
+        std::coroutine_handle<> next = done.promise().continuation;
+        return next ? next : std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+    };
+    final_awaiter final_suspend() noexcept { return {}; }
+    void return_value(T v) { value.emplace(std::move(v)); }
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  throwing_task(throwing_task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  ~throwing_task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiting) noexcept {
+    handle_.promise().continuation = waiting;
+    return handle_;
+  }
+  T await_resume() {
+    if (handle_.promise().error) {
+      std::rethrow_exception(handle_.promise().error);
+    }
+    return std::move(*handle_.promise().value);
+  }
+
+  T run() {
+    handle_.resume();
+    return await_resume();
+  }
+
+private:
+  explicit throwing_task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  std::coroutine_handle<promise_type> handle_;
+};
+
+BENCH_NOINLINE error_result<long> step(long i, bool fail) {
+  if (fail) {
+    return error_fail(FooErrors::eBAR);
+  }
+  return i + 1;
+}
+
+BENCH_NOINLINE long step_throwing(long i, bool fail) {
+  if (fail) {
+    raise_typed<FooErrors::eBAR>();
+  }
+  return i + 1;
+}
+
+error_task<long> returning(int depth, long i, bool fail) {
+  if (depth == 0) {
+    co_return co_await step(i, fail);
+  }
+  long n = co_await returning(depth - 1, i, fail);
+  co_return n + 1;
+}
+
+throwing_task<long> throwing(int depth, long i, bool fail) {
+  if (depth == 0) {
+    co_return step_throwing(i, fail);
+  }
+  long n = co_await throwing(depth - 1, i, fail);
+  co_return n + 1;
+}
+
+long run_returning(long i, bool fail) {
+  error_result<long> r = returning(3, i, fail).run();
+  return r.ok() ? r.value() : -1;
+}
+
+long run_throwing(long i, bool fail) {
+  try {
+    return throwing(3, i, fail).run();
+  } catch (const typed_error_base &) {
+    return -1;
+  }
+}
+}
+
+int main() {
+  const long iterations = 200000;
+  // bench_sink += ... is deprecated on a volatile in C++20
+  bench_report("error_task, depth 4, success", bench_ns([](long i) { bench_sink = bench_sink + run_returning(i, false); }, iterations));
+  bench_report("error_task, depth 4, failure", bench_ns([](long i) { bench_sink = bench_sink + run_returning(i, true); }, iterations));
+  bench_report("exception task, depth 4, success",
+               bench_ns([](long i) { bench_sink = bench_sink + run_throwing(i, false); }, iterations));
+  bench_report("exception task, depth 4, failure",
+               bench_ns([](long i) { bench_sink = bench_sink + run_throwing(i, true); }, iterations));
+  return 0;
+}
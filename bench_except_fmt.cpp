@@ -0,0 +1,76 @@
+/*
+ * bench_except_fmt.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "except_fmt.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+const std::string name = "/var/lib/service/config/request-handler.ini";
+
+BENCH_NOINLINE void throw_eager(long i) {
+  char text[ERROR_ID_FMT_TEXT];
+  std::snprintf(text, sizeof(text), "cannot open %s (%ld)", name.c_str(), i);
+  throw typed_error<FooErrors::eFOO>(text);
+}
+
+BENCH_NOINLINE void throw_lazy(long i) {
+  throw make_typed_error<FooErrors::eFOO>("cannot open %s (%ld)", name, i);
+}
+}
+
+int main() {
+  const long iterations = 1000000;
+
+  bench_report("typed_error formatted at throw, type() only",
+               bench_ns([](long i) {
+                 try {
+                   throw_eager(i);
+                 } catch (const typed_error_base &e) {
+                   bench_sink += (e.type() == FooErrors::eFOO);
+                 }
+               },
+                        iterations));
+
+  bench_report("typed_error_fmt, type() only",
+               bench_ns([](long i) {
+                 try {
+                   throw_lazy(i);
+                 } catch (const typed_error_base &e) {
+                   bench_sink += (e.type() == FooErrors::eFOO);
+                 }
+               },
+                        iterations));
+
+  bench_report("typed_error formatted at throw, what() read",
+               bench_ns([](long i) {
+                 try {
+                   throw_eager(i);
+                 } catch (const std::exception &e) {
+                   bench_sink += e.what()[0];
+                 }
+               },
+                        iterations));
+
+  bench_report("typed_error_fmt, what() read",
+               bench_ns([](long i) {
+                 try {
+                   throw_lazy(i);
+                 } catch (const std::exception &e) {
+                   bench_sink += e.what()[0];
+                 }
+               },
+                        iterations));
+  return 0;
+}
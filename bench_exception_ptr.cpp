@@ -0,0 +1,40 @@
+/*
+ * bench_exception_ptr.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <exception>
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+int main() {
+  const long waiters = 4096;
+  const long rounds = 1000;
+
+  // each round fails every waiter, as a shared failure fanning out would
+  std::vector<std::exception_ptr> slots(waiters);
+
+  bench_report("make_exception_ptr per waiter",
+               bench_ns([&slots](long i) {
+                 slots[i % slots.size()] = std::make_exception_ptr(typed_error_lite<FooErrors::eFOO>());
+               },
+                        waiters * rounds));
+
+  bench_report("lite_exception_ptr per waiter",
+               bench_ns([&slots](long i) {
+                 slots[i % slots.size()] = lite_exception_ptr<FooErrors::eFOO>();
+               },
+                        waiters * rounds));
+
+  bench_sink += (slots[0] == lite_exception_ptr<FooErrors::eFOO>());
+  return 0;
+}
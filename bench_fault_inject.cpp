@@ -0,0 +1,49 @@
+/*
+ * bench_fault_inject.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "fault_inject.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+BENCH_NOINLINE error_value plain_work(long i) {
+  bench_sink += i;
+  return NULL;
+}
+
+BENCH_NOINLINE error_value injectable_work(long i) {
+  if (error_value err = ERROR_ID_INJECT("bench.injectable_work")) {
+    return err;
+  }
+  bench_sink += i;
+  return NULL;
+}
+}
+
+int main() {
+  const long iterations = 100000000;
+
+  bench_report("no injection point",
+               bench_ns([](long i) { bench_sink += (plain_work(i) != NULL); }, iterations));
+
+  bench_report("injection point, disabled",
+               bench_ns([](long i) { bench_sink += (injectable_work(i) != NULL); }, iterations));
+
+  fault_injection::arm("bench.injectable_work", FooErrors::ePOR, 0.0);
+  fault_injection::enable();
+  bench_report("injection point, enabled, never fires",
+               bench_ns([](long i) { bench_sink += (injectable_work(i) != NULL); }, iterations / 10));
+
+  fault_injection::arm("bench.injectable_work", FooErrors::ePOR, 0.01);
+  bench_report("injection point, enabled, fires 1%",
+               bench_ns([](long i) { bench_sink += (injectable_work(i) != NULL); }, iterations / 10));
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * bench_location.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// error_location::parse against the std::regex split it replaces, over
+// SCOPE_ERROR_LOCATION texts with realistic paths
+
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "error_location.hpp"
+
+BENCH_SINK_DEFINITION
+
+int main() {
+  std::vector<std::string> texts;
+  for (int i = 0; i < 1000; ++i) {
+    texts.push_back("/home/build/work/project/src/module" + std::to_string(i % 37) + "/source_file.cpp:"
+                    + std::to_string(100 + i) + " GRP-NET: Connection refused by peer ");
+  }
+  size_t bytes = 0;
+  for (size_t i = 0; i < texts.size(); ++i) {
+    bytes += texts[i].size();
+  }
+  const long iterations = 200;
+
+  const std::regex pattern("^(.*):([0-9]+) ([^- :]+)-([^ :]+): (.*) $");
+  double regex_ns = bench_ns([&](long) {
+    std::smatch m;
+    for (size_t t = 0; t < texts.size(); t += 10) {
+      if (std::regex_match(texts[t], m, pattern)) {
+        bench_sink += m[2].length();
+      }
+    }
+  }, iterations / 10);
+  bench_report("std::regex, 100 texts", regex_ns);
+
+  double parse_ns = bench_ns([&](long) {
+    error_location where;
+    for (size_t t = 0; t < texts.size(); ++t) {
+      if (error_location::parse(texts[t].data(), texts[t].size(), where)) {
+        bench_sink += where.line;
+      }
+    }
+  }, iterations);
+  bench_report("error_location::parse, 1000 texts", parse_ns);
+
+  std::printf("std::regex %.1f MB/s, error_location::parse %.1f MB/s\n", bytes / 10 / regex_ns * 1e3,
+              bytes / parse_ns * 1e3);
+  return 0;
+}
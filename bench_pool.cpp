@@ -0,0 +1,122 @@
+/*
+ * bench_pool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// fork/join of small tasks, one in ten failing, on 1..N threads:
+// std::async with the failures thrown and rethrown by future::get(),
+// against error_pool::map with them returned as error_result
+//
+// usage: bench_pool [max_threads]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "error_pool.hpp"
+#include "error_result.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+
+const size_t tasks = 4096;
+
+// about a microsecond of work
+BENCH_NOINLINE long work(size_t i) {
+  unsigned long x = i + 1;
+  for (int k = 0; k < 400; ++k) {
+    x = x * 6364136223846793005UL + 1442695040888963407UL;
+  }
+  return static_cast<long>(x >> 33);
+}
+
+long task_throwing(size_t i) {
+  long value = work(i);
+  if (i % 10 == 7) {
+    raise_typed<FooErrors::eBAR>();
+  }
+  return value;
+}
+
+error_result<long> task_returning(size_t i) {
+  long value = work(i);
+  if (i % 10 == 7) {
+    return error_fail(FooErrors::eBAR);
+  }
+  return value;
+}
+
+// tasks per second, the std::async futures launched threads at a time
+double async_rate(unsigned threads) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  long failed = 0;
+  for (size_t first = 0; first < tasks; first += threads) {
+    std::vector<std::future<long> > wave;
+    for (size_t i = first; i < first + threads && i < tasks; ++i) {
+      wave.push_back(std::async(std::launch::async, task_throwing, i));
+    }
+    for (size_t w = 0; w < wave.size(); ++w) {
+      try {
+        bench_sink += wave[w].get();
+      } catch (const typed_error_base &) {
+        ++failed;
+      }
+    }
+  }
+  bench_sink += failed;
+  return tasks / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double pool_rate(unsigned threads) {
+  error_pool pool(threads);
+  std::vector<error_result<long> > out(tasks, error_result<long>(0L));
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const int rounds = 20;
+  for (int r = 0; r < rounds; ++r) {
+    bench_sink += pool.map(tasks, task_returning, &out[0], 16) == FooErrors::eBAR;
+  }
+  return rounds * tasks / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char *argv[]) {
+  unsigned max_threads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    max_threads = std::atoi(argv[1]);
+  }
+  if (max_threads == 0) {
+    max_threads = 1;
+  }
+  // powers of two, always finishing with max_threads itself
+  std::vector<unsigned> counts;
+  for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+
+  double async_single = 0;
+  double pool_single = 0;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    double async_tasks = async_rate(counts[i]);
+    double pool_tasks = pool_rate(counts[i]);
+    if (i == 0) {
+      async_single = async_tasks;
+      pool_single = pool_tasks;
+    }
+    std::printf("threads %3u  std::async %12.0f tasks/s (%5.1f%%)  error_pool %12.0f tasks/s (%5.1f%%)\n", counts[i],
+                async_tasks, 100.0 * async_tasks / (async_single * counts[i]), pool_tasks,
+                100.0 * pool_tasks / (pool_single * counts[i]));
+  }
+  return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * bench_raise.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// the latency of raise_id from raise to recovery, built twice by the
+// Makefile: with exceptions it throws and is caught, with -fno-exceptions
+// (Default/noexcept/bench_raise) it goes through the raise handler, which
+// longjmps back
+
+#include <csetjmp>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "raise_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+
+std::jmp_buf raise_point;
+
+void longjmp_handler(error_value, const char *) { std::longjmp(raise_point, 1); }
+
+BENCH_NOINLINE void fail(long i) {
+  if (i >= 0) {
+    raise_id(FooErrors::eFOO);
+  }
+}
+
+void raise_and_recover(long i) {
+#if ERROR_ID_HAS_EXCEPTIONS
+  try {
+    fail(i);
+  } catch (error_value err) {
+    bench_sink += err == FooErrors::eFOO;
+  }
+#else
+  if (setjmp(raise_point) == 0) {
+    fail(i);
+  } else {
+    bench_sink += 1;
+  }
+#endif
+}
+}
+
+int main() {
+  const long iterations = 1000000;
+
+  set_error_raise_handler(longjmp_handler);
+#if ERROR_ID_HAS_EXCEPTIONS
+  bench_report("raise_id, thrown and caught", bench_ns(raise_and_recover, iterations));
+#else
+  bench_report("raise_id, handler and longjmp (-fno-exceptions)", bench_ns(raise_and_recover, iterations));
+#endif
+  return 0;
+}
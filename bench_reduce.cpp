@@ -0,0 +1,71 @@
+/*
+ * bench_reduce.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// the reductions of error_reduce against the plain loops they replace,
+// over 100k step results with 0.1% failures
+
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "error_reduce.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+BENCH_NOINLINE size_t first_loop(const error_value *values, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if (values[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+BENCH_NOINLINE size_t count_loop(const error_value *values, size_t n) {
+  size_t failed = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (values[i]) {
+      ++failed;
+    }
+  }
+  return failed;
+}
+}
+
+int main() {
+  const size_t n = 100000;
+  const long iterations = 2000;
+
+  std::vector<error_value> results(n, NULL);
+  for (size_t i = 999; i < n; i += 1000) {
+    results[i] = i % 3000 == 999 ? FooErrors::eBAR : FooErrors::eFOO;
+  }
+  // the first failure is the last result, so first() scans the whole batch
+  std::vector<error_value> late(n, NULL);
+  late[n - 1] = FooErrors::eFOO;
+
+  std::printf("AVX2 kernels: %s\n", error_reduce::vectorised() ? "yes" : "no");
+
+  bench_report("loop, first failure (100k)", bench_ns([&](long) { bench_sink += first_loop(&late[0], n); }, iterations));
+  bench_report("error_reduce::first (100k)",
+               bench_ns([&](long) { bench_sink += error_reduce::first(&late[0], n); }, iterations));
+
+  bench_report("loop, count failures (100k)",
+               bench_ns([&](long) { bench_sink += count_loop(&results[0], n); }, iterations));
+  bench_report("error_reduce::count (100k)",
+               bench_ns([&](long) { bench_sink += error_reduce::count(&results[0], n); }, iterations));
+
+  std::vector<size_t> counts;
+  bench_report("error_reduce::histogram (100k)", bench_ns([&](long) {
+    error_reduce::histogram(&results[0], n, counts);
+  }, iterations));
+  bench_sink += counts.size();
+  return 0;
+}
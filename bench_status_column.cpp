@@ -0,0 +1,58 @@
+/*
+ * bench_status_column.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// scanning the status of a 100k row batch with 0.1% failures, held as an
+// error_value per row against error_status_column's 16 bit indices
+
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "error_status.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+int main() {
+  const size_t rows = 100000;
+  const long iterations = 2000;
+
+  std::vector<error_value> values(rows, NULL);
+  error_status_column status(rows);
+  for (size_t row = 7; row < rows; row += 1000) {
+    values[row] = FooErrors::eBAR;
+    status.set(row, FooErrors::eBAR);
+  }
+
+  bench_report("error_value per row, count (100k rows)", bench_ns([&](long) {
+    size_t failed = 0;
+    for (size_t row = 0; row < rows; ++row) {
+      failed += values[row] != NULL;
+    }
+    bench_sink += failed;
+  }, iterations));
+
+  bench_report("status column, count (100k rows)", bench_ns([&](long) { bench_sink += status.count(); }, iterations));
+
+  bench_report("error_value per row, visit failures (100k rows)", bench_ns([&](long) {
+    for (size_t row = 0; row < rows; ++row) {
+      if (values[row]) {
+        bench_sink += row;
+      }
+    }
+  }, iterations));
+
+  bench_report("status column, visit failures (100k rows)", bench_ns([&](long) {
+    status.for_each_error([](size_t row, error_value) { bench_sink += row; });
+  }, iterations));
+
+  status.clear_all();
+  bench_report("status column, any() all succeeded (100k rows)",
+               bench_ns([&](long) { bench_sink += status.any(); }, iterations));
+  return 0;
+}
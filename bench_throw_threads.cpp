@@ -0,0 +1,136 @@
+/*
+ * bench_throw_threads.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// how throw/catch of typed_error scales with threads and stack depth,
+// against returning the same error_value up the same stack
+// the unwinder's FDE lookup has historically been serialised by a global
+// lock, which shows as scaling efficiency well below 100%
+//
+// usage: bench_throw_threads [max_threads]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+BENCH_SINK_DEFINITION
+
+namespace {
+
+BENCH_NOINLINE long throw_at_depth(long depth) {
+  if (depth > 0) {
+    // the addition keeps each level as a real frame rather than a tail call
+    return throw_at_depth(depth - 1) + 1;
+  }
+  throw typed_error<FooErrors::eFOO>();
+}
+
+BENCH_NOINLINE error_value return_at_depth(long depth, long &out) {
+  if (depth == 0) {
+    return FooErrors::eFOO;
+  }
+  error_value err = return_at_depth(depth - 1, out);
+  if (err) {
+    return err;
+  }
+  out += 1;
+  return NULL;
+}
+
+long throw_loop(long depth, long iterations) {
+  long caught = 0;
+  for (long i = 0; i < iterations; ++i) {
+    try {
+      bench_sink += throw_at_depth(depth);
+    } catch (const typed_error<FooErrors::eFOO> &e) {
+      ++caught;
+    }
+  }
+  return caught;
+}
+
+long return_loop(long depth, long iterations) {
+  long failed = 0;
+  for (long i = 0; i < iterations; ++i) {
+    long out = 0;
+    if (return_at_depth(depth, out) == FooErrors::eFOO) {
+      ++failed;
+    }
+  }
+  return failed;
+}
+
+// runs loop on each of threads threads, returning total operations per second
+double throughput(long (*loop)(long, long), unsigned threads, long depth, long iterations) {
+  std::vector<std::thread> workers;
+  std::vector<long> counts(threads);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.push_back(std::thread([&counts, t, loop, depth, iterations] { counts[t] = loop(depth, iterations); }));
+  }
+  for (unsigned t = 0; t < threads; ++t) {
+    workers[t].join();
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  long total = 0;
+  for (unsigned t = 0; t < threads; ++t) {
+    total += counts[t];
+  }
+  bench_sink += total;
+  return (double(threads) * iterations) / std::chrono::duration<double>(end - start).count();
+}
+
+void report(const char *name, long (*loop)(long, long), unsigned max_threads, long depth, long iterations) {
+  // powers of two, always finishing with max_threads itself
+  std::vector<unsigned> counts;
+  for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+
+  double single = 0;
+  for (unsigned i = 0; i < counts.size(); ++i) {
+    double ops = throughput(loop, counts[i], depth, iterations);
+    if (i == 0) {
+      single = ops;
+    }
+    std::printf("%-8s depth %3ld threads %3u %14.0f ops/s  efficiency %5.1f%%\n", name, depth, counts[i], ops,
+                100.0 * ops / (single * counts[i]));
+  }
+}
+}
+
+int main(int argc, char *argv[]) {
+  unsigned max_threads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    // strtoul skips blanks and takes "-1" as ULONG_MAX, so only digits pass
+    char *end = NULL;
+    unsigned long n = std::strtoul(argv[1], &end, 10);
+    if (argv[1][0] < '0' || argv[1][0] > '9' || *end || n == 0 || n > 1024) {
+      std::fprintf(stderr, "bench_throw_threads: max_threads %s is not a number from 1 to 1024\n", argv[1]);
+      return 1;
+    }
+    max_threads = static_cast<unsigned>(n);
+  }
+  if (max_threads == 0) {
+    max_threads = 1;
+  }
+
+  const long depths[] = { 1, 8, 32 };
+  for (unsigned d = 0; d < sizeof(depths) / sizeof(depths[0]); ++d) {
+    report("throw", throw_loop, max_threads, depths[d], 100000);
+    report("return", return_loop, max_threads, depths[d], 10000000);
+  }
+  return 0;
+}
@@ -0,0 +1,265 @@
+/*
+ * corpus_gen.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// generates a synthetic code base with a large number of error_ids, to see
+// how the approach scales as a library grows:
+//
+//   corpus.tsv          the error_ids, spread evenly across packages, as a
+//                       catalog for error_catalog_gen
+//   CORPUS_Pnnn_sites.cpp  per package, a typed_error throw site for every
+//                       error_id, a CheckList handler set covering them and a
+//                       table of the ids, either error_values (one dynamic
+//                       relocation each in a PIE) or the catalog's error_refs
+//   corpus.hpp          the typelist handler templates
+//   corpus_main.cpp     the driver: "--startup" exits straight away, otherwise
+//                       it reports the throw + dispatch and dispatch-only latency
+//   corpus.mk           builds it all, given CXX, CXXFLAGS, SRC_DIR and LIB_OBJS
+//
+// corpus_metrics.sh runs this and error_catalog_gen and records the timings
+//
+// usage: corpus_gen error_count package_count output_dir [pointers|refs]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "error_catalog.hpp"
+
+namespace {
+
+// handler typelists are split so template recursion stays well inside the
+// compiler's instantiation depth limit
+const unsigned list_length = 32;
+
+void fail(const std::string &message) {
+  std::fprintf(stderr, "corpus_gen: %s\n", message.c_str());
+  std::exit(1);
+}
+
+std::string banner(const std::string &file) {
+  return "/*\n * " + file + "\n *\n *  generated by corpus_gen - do not edit\n */\n\n";
+}
+
+std::string package_name(unsigned p) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "P%03u", p);
+  return name;
+}
+
+std::string error_name(unsigned e) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "e%05u", e);
+  return name;
+}
+
+void write(const std::string &path, const std::string &content) {
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  out << content;
+  if (!out) {
+    fail("cannot write " + path);
+  }
+}
+
+// error e belongs to package e % packages, at position e / packages
+unsigned package_size(unsigned errors, unsigned packages, unsigned p) {
+  return errors / packages + (p < errors % packages ? 1 : 0);
+}
+
+std::string catalog(unsigned errors, unsigned packages) {
+  std::ostringstream os;
+  os << "# synthetic catalog generated by corpus_gen - do not edit\n";
+  std::set<uint32_t> codes;
+  for (unsigned e = 0; e < errors; ++e) {
+    std::string package = package_name(e % packages);
+    std::string name = error_name(e);
+    os << "CORPUS\t" << package << "\t" << name << "\tSynthetic error " << e << "\t" << (e % 7 ? "error" : "warning")
+       << "\t" << (e % 3 ? "no" : "yes");
+    // error_catalog_gen rejects colliding stable codes, so pin a free one
+    uint32_t code = error_catalog_code("CORPUS", package.c_str(), name.c_str());
+    if (!codes.insert(code).second) {
+      while (!codes.insert(++code).second) {
+      }
+      os << "\t" << code;
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
+std::string common_header() {
+  std::ostringstream os;
+  os << banner("corpus.hpp");
+  os << "#ifndef CORPUS_HPP_\n#define CORPUS_HPP_\n\n";
+  os << "#include \"error_id.hpp\"\n\n";
+  os << "// counts the handlers run, so the dispatch cannot be optimised away\n";
+  os << "extern volatile unsigned long corpus_handled;\n\n";
+  os << "template <error_id x> struct ErrorHandler {\n";
+  os << "  void operator()() { corpus_handled = corpus_handled + 1; }\n};\n\n";
+  os << "struct FallThrough;\n";
+  os << "template <error_id x, typename xs> struct ErrorList;\n\n";
+  os << "template <typename T> struct CheckList {};\n\n";
+  os << "template <> struct CheckList<FallThrough> {\n";
+  os << "  void operator()(error_value, bool &) {}\n};\n\n";
+  os << "template <error_id x, typename xs> struct CheckList<ErrorList<x, xs> > {\n";
+  os << "  void operator()(error_value n, bool &handled) {\n";
+  os << "    if (x == n) {\n      handled = true;\n      ErrorHandler<x>()();\n    }\n";
+  os << "    if (!handled) {\n      CheckList<xs>()(n, handled);\n    }\n  }\n};\n\n";
+  os << "struct corpus_package {\n";
+  os << "  void (*raise)(unsigned position);\n";
+  os << "  bool (*handle)(error_value err);\n";
+  os << "  error_value (*id)(unsigned position);\n";
+  os << "  unsigned size;\n};\n\n";
+  os << "#endif /* CORPUS_HPP_ */\n";
+  return os.str();
+}
+
+std::string sites_source(unsigned errors, unsigned packages, unsigned p, bool refs) {
+  std::string ns = "CORPUS_" + package_name(p);
+  unsigned size = package_size(errors, packages, p);
+  std::ostringstream os;
+  os << banner(ns + "_sites.cpp");
+  os << "#include \"corpus.hpp\"\n#include \"except_id.hpp\"\n\n#include \"" << ns << "_errors.h\"\n\n";
+
+  os << "void " << ns << "_raise(unsigned position) {\n  switch (position) {\n";
+  for (unsigned i = 0; i < size; ++i) {
+    std::string name = error_name(i * packages + p);
+    os << "  case " << i << ":\n    raise_typed<" << ns << "::" << name << ">();\n";
+  }
+  os << "  }\n}\n\n";
+
+  unsigned lists = (size + list_length - 1) / list_length;
+  os << "namespace {\n\n";
+  for (unsigned l = 0; l < lists; ++l) {
+    os << "typedef ";
+    unsigned end = (l + 1) * list_length < size ? (l + 1) * list_length : size;
+    for (unsigned i = l * list_length; i < end; ++i) {
+      os << "ErrorList<" << ns << "::" << error_name(i * packages + p) << ", ";
+    }
+    os << "FallThrough";
+    for (unsigned i = l * list_length; i < end; ++i) {
+      os << " >";
+    }
+    os << " list" << l << ";\n";
+  }
+  os << "\n}\n\n";
+
+  os << "bool " << ns << "_handle(error_value err) {\n  bool handled = false;\n";
+  for (unsigned l = 0; l < lists; ++l) {
+    os << (l ? "  if (!handled) {\n  " : "  {\n  ") << "  CheckList<list" << l << ">()(err, handled);\n  }\n";
+  }
+  os << "  return handled;\n}\n\n";
+
+  if (refs) {
+    os << "error_value " << ns << "_id(unsigned position) {\n  return " << ns << "_refs[position].value();\n}\n";
+  } else {
+    os << "extern const error_value " << ns << "_table[] = {\n";
+    for (unsigned i = 0; i < size; ++i) {
+      os << "  " << ns << "::" << error_name(i * packages + p) << ",\n";
+    }
+    os << "};\n\nerror_value " << ns << "_id(unsigned position) {\n  return " << ns << "_table[position];\n}\n";
+  }
+  return os.str();
+}
+
+std::string driver_source(unsigned errors, unsigned packages) {
+  std::ostringstream os;
+  os << banner("corpus_main.cpp");
+  os << "#include <cstdio>\n#include <cstdlib>\n#include <cstring>\n#include <vector>\n\n";
+  os << "#include \"bench.hpp\"\n#include \"corpus.hpp\"\n#include \"error_registry.hpp\"\n#include \"except_id.hpp\"\n\n";
+  os << "BENCH_SINK_DEFINITION\n\nvolatile unsigned long corpus_handled = 0;\n\n";
+  for (unsigned p = 0; p < packages; ++p) {
+    std::string ns = "CORPUS_" + package_name(p);
+    os << "void " << ns << "_raise(unsigned position);\nbool " << ns << "_handle(error_value err);\n";
+    os << "error_value " << ns << "_id(unsigned position);\n";
+  }
+  os << "\nnamespace {\n\nconst corpus_package packages[] = {\n";
+  for (unsigned p = 0; p < packages; ++p) {
+    std::string ns = "CORPUS_" + package_name(p);
+    os << "  { " << ns << "_raise, " << ns << "_handle, " << ns << "_id, " << package_size(errors, packages, p) << " },\n";
+  }
+  os << "};\n\n";
+  os << "const unsigned package_count = " << packages << ";\nconst unsigned error_count = " << errors << ";\n\n";
+  os << "struct site {\n  unsigned package;\n  unsigned position;\n  error_value err;\n};\n\n";
+  os << "}\n\n";
+  os << "int main(int argc, char *argv[]) {\n";
+  os << "  // the process cost up to here is what the harness times as startup\n";
+  os << "  if (argc > 1 && !std::strcmp(argv[1], \"--startup\")) {\n    return 0;\n  }\n";
+  os << "  long iterations = argc > 1 ? std::atol(argv[1]) : 100000;\n\n";
+  os << "  if (error_registry::size() < error_count) {\n";
+  os << "    std::fprintf(stderr, \"only %u of %u error_ids registered\\n\", error_registry::size(), error_count);\n";
+  os << "    return 1;\n  }\n\n";
+  os << "  // a fixed pseudo random walk over every package and position\n";
+  os << "  std::vector<site> sites(4096);\n  unsigned state = 2463534242u;\n";
+  os << "  for (unsigned i = 0; i < sites.size(); ++i) {\n";
+  os << "    state ^= state << 13;\n    state ^= state >> 17;\n    state ^= state << 5;\n";
+  os << "    sites[i].package = state % package_count;\n";
+  os << "    sites[i].position = (state / package_count) % packages[sites[i].package].size;\n";
+  os << "    sites[i].err = packages[sites[i].package].id(sites[i].position);\n";
+  os << "    try {\n      packages[sites[i].package].raise(sites[i].position);\n";
+  os << "    } catch (const typed_error_base &e) {\n      if (e.type() != sites[i].err) {\n";
+  os << "        std::fprintf(stderr, \"id table does not match the throw sites\\n\");\n        return 1;\n";
+  os << "      }\n    }\n  }\n\n";
+  os << "  double dispatch = bench_ns([&](long i) {\n";
+  os << "    const site &s = sites[i & 4095];\n";
+  os << "    bench_sink += packages[s.package].handle(s.err);\n  }, iterations);\n\n";
+  os << "  double throw_dispatch = bench_ns([&](long i) {\n";
+  os << "    const site &s = sites[i & 4095];\n    try {\n      packages[s.package].raise(s.position);\n";
+  os << "    } catch (const typed_error_base &e) {\n      bench_sink += packages[s.package].handle(e.type());\n";
+  os << "    }\n  }, iterations);\n\n";
+  os << "  if (bench_sink != 2 * iterations) {\n    std::fprintf(stderr, \"unhandled errors\\n\");\n    return 1;\n  }\n";
+  os << "  std::printf(\"dispatch_ns\\t%.1f\\nthrow_dispatch_ns\\t%.1f\\n\", dispatch, throw_dispatch);\n";
+  os << "  return 0;\n}\n";
+  return os.str();
+}
+
+std::string makefile(unsigned packages) {
+  std::ostringstream os;
+  os << "# generated by corpus_gen - do not edit\n";
+  os << "# make -f corpus.mk CXX=... CXXFLAGS=... SRC_DIR=... LIB_OBJS=... [objects|corpus]\n\n";
+  os << "CORPUS_DIR := $(dir $(lastword $(MAKEFILE_LIST)))\n\n";
+  os << "CORPUS_OBJS = $(CORPUS_DIR)corpus_main.o $(CORPUS_DIR)error_catalog_index.o";
+  for (unsigned p = 0; p < packages; ++p) {
+    std::string ns = "CORPUS_" + package_name(p);
+    os << "\\\n\t$(CORPUS_DIR)" << ns << "_errors.o $(CORPUS_DIR)" << ns << "_sites.o";
+  }
+  os << "\n\ncorpus: $(CORPUS_DIR)corpus\n\nobjects: $(CORPUS_OBJS)\n\n";
+  os << "$(CORPUS_DIR)corpus: $(CORPUS_OBJS)\n\t$(CXX) -o $@ $(CORPUS_OBJS) $(LIB_OBJS) $(CXXFLAGS)\n\n";
+  os << "$(CORPUS_DIR)%.o: $(CORPUS_DIR)%.cpp\n\t$(CXX) -c -o $@ $< -I$(SRC_DIR) -I$(CORPUS_DIR) $(CXXFLAGS)\n\n";
+  os << ".PHONY: corpus objects\n";
+  return os.str();
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 4 && argc != 5) {
+    std::fprintf(stderr, "usage: corpus_gen error_count package_count output_dir [pointers|refs]\n");
+    return 2;
+  }
+  unsigned errors = std::strtoul(argv[1], NULL, 10);
+  unsigned packages = std::strtoul(argv[2], NULL, 10);
+  std::string dir = argv[3];
+  std::string tables = argc > 4 ? argv[4] : "pointers";
+  if (!packages || packages > 1000 || errors < packages) {
+    fail("need 1 to 1000 packages and at least one error_id per package");
+  }
+  if (tables != "pointers" && tables != "refs") {
+    fail("tables must be pointers or refs");
+  }
+
+  write(dir + "/corpus.tsv", catalog(errors, packages));
+  write(dir + "/corpus.hpp", common_header());
+  for (unsigned p = 0; p < packages; ++p) {
+    write(dir + "/CORPUS_" + package_name(p) + "_sites.cpp", sites_source(errors, packages, p, tables == "refs"));
+  }
+  write(dir + "/corpus_main.cpp", driver_source(errors, packages));
+  write(dir + "/corpus.mk", makefile(packages));
+  return 0;
+}
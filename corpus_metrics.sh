@@ -0,0 +1,85 @@
+#!/bin/sh
+#
+# corpus_metrics.sh
+#
+#  Created on: 18 Oct 2026
+#      Author: patrick
+#
+# builds a synthetic corpus (see corpus_gen.cpp) of each requested size and
+# records compile time, link time, binary size, dynamic relocations, startup
+# time and dispatch latency, one line per size and table kind, appended to
+# Default/corpus/metrics.tsv so runs can be compared as the library grows
+#
+# usage: corpus_metrics.sh size...     (run by "make corpus")
+#
+# CXX, CXXFLAGS, JOBS, PER_PACKAGE (error_ids per package, default 100),
+# TABLES (how the id tables are held, "pointers" and/or "refs", see
+# error_handle.hpp) and LIB_OBJS (the library objects to link) come from
+# the environment
+
+set -e
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--std=c++0x -O2}
+JOBS=${JOBS:-$(nproc 2>/dev/null || echo 4)}
+PER_PACKAGE=${PER_PACKAGE:-100}
+TABLES=${TABLES:-pointers}
+LIB_OBJS=${LIB_OBJS:-"error_catalog.o error_registry.o"}
+SRC_DIR=$(pwd)
+OUT=Default/corpus
+METRICS=$OUT/metrics.tsv
+
+now_ms() {
+	echo $(($(date +%s%N) / 1000000))
+}
+
+mkdir -p $OUT
+if [ ! -f $METRICS ]; then
+	printf "date\trevision\terrors\tpackages\ttables\tcompile_ms\tlink_ms\tbinary_bytes\trelocations\tstartup_us\tdispatch_ns\tthrow_dispatch_ns\n" > $METRICS
+fi
+revision=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+for size in "$@"; do
+for tables in $TABLES; do
+	packages=$(((size + PER_PACKAGE - 1) / PER_PACKAGE))
+	dir=$OUT/$size-$tables
+	rm -rf $dir
+	mkdir -p $dir
+
+	./Default/corpus_gen $size $packages $dir $tables
+	./Default/error_catalog_gen $dir/corpus.tsv $dir
+	build="make -s -f $dir/corpus.mk -j$JOBS CXX=$CXX SRC_DIR=$SRC_DIR"
+
+	start=$(now_ms)
+	$build CXXFLAGS="$CXXFLAGS" objects
+	compile=$(($(now_ms) - start))
+
+	start=$(now_ms)
+	$build CXXFLAGS="$CXXFLAGS" LIB_OBJS="$LIB_OBJS" corpus
+	link=$(($(now_ms) - start))
+
+	bytes=$(wc -c < $dir/corpus)
+	relocations=$(readelf -r $dir/corpus 2>/dev/null | grep -c "^[0-9a-f]" || true)
+
+	# mean of several runs, each paying static initialisation and loading
+	runs=20
+	start=$(date +%s%N)
+	i=0
+	while [ $i -lt $runs ]; do
+		./$dir/corpus --startup
+		i=$((i + 1))
+	done
+	startup=$((($(date +%s%N) - start) / runs / 1000))
+
+	latency=$(./$dir/corpus)
+	dispatch=$(echo "$latency" | awk '$1 == "dispatch_ns" { print $2 }')
+	throw_dispatch=$(echo "$latency" | awk '$1 == "throw_dispatch_ns" { print $2 }')
+
+	line="$(date +%Y-%m-%dT%H:%M:%S)\t$revision\t$size\t$packages\t$tables\t$compile\t$link\t$bytes\t$relocations\t$startup\t$dispatch\t$throw_dispatch"
+	printf "$line\n" >> $METRICS
+	printf "%6s error_ids in %3s packages, %-8s: compile %6s ms, link %5s ms, %9s bytes, %7s relocations, startup %5s us, dispatch %6s ns, throw+dispatch %7s ns\n" \
+		$size $packages $tables $compile $link $bytes $relocations $startup $dispatch $throw_dispatch
+done
+done
+
+echo "results appended to $METRICS"
@@ -0,0 +1,69 @@
+/*
+ * error_catalog.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_catalog.hpp"
+
+#include <atomic>
+
+#include "error_registry.hpp"
+
+namespace {
+
+// constant initialised, like the registry itself
+std::atomic<const error_descriptor *> by_index[error_registry::max_ids + 1];
+std::atomic<const error_catalog_index *> indices[error_catalog::max_indices];
+std::atomic<unsigned> index_count(0);
+
+}
+
+void error_catalog::add(const error_descriptor *descriptors, unsigned count) {
+  for (unsigned i = 0; i < count; ++i) {
+    unsigned index = error_registry::add(descriptors[i].id);
+    if (index) {
+      by_index[index].store(&descriptors[i], std::memory_order_release);
+    }
+  }
+}
+
+bool error_catalog::add_index(const error_catalog_index *index) {
+  unsigned slot = index_count.fetch_add(1, std::memory_order_relaxed);
+  if (slot >= max_indices) {
+    index_count.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  indices[slot].store(index, std::memory_order_release);
+  return true;
+}
+
+const error_descriptor *error_catalog::find(error_value id) {
+  unsigned index = error_registry::index_of(id);
+  return index ? by_index[index].load(std::memory_order_acquire) : NULL;
+}
+
+const error_descriptor *error_catalog::find_code(uint32_t code) {
+  unsigned count = index_count.load(std::memory_order_acquire);
+  if (count > max_indices) {
+    count = max_indices;
+  }
+  for (unsigned i = 0; i < count; ++i) {
+    const error_catalog_index *index = indices[i].load(std::memory_order_acquire);
+    if (!index || !index->slot_count) {
+      continue;
+    }
+    uint32_t displacement = index->displacements[error_catalog_hash(code, 0) % index->displacement_count];
+    const error_descriptor *d = index->slots[error_catalog_hash(code, displacement) % index->slot_count];
+    if (d && d->code == code) {
+      return d;
+    }
+  }
+  return NULL;
+}
+
+uint32_t error_catalog::code_of(error_value id) {
+  const error_descriptor *d = find(id);
+  return d ? d->code : error_stable_code(id);
+}
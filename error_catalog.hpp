@@ -0,0 +1,111 @@
+/*
+ * error_catalog.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_CATALOG_HPP_
+#define ERROR_CATALOG_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// metadata for error_ids generated from a catalog file by error_catalog_gen
+// each generated package registers its descriptors at startup, and the
+// generated index gives a perfect hash from stable code back to descriptor
+//
+// the stable code is a hash of what identifies the error - its group,
+// package and symbolic name, not its message - so unlike the pointer it is the
+// same in every build and every process, and rewording a message keeps it:
+// suitable for logs, wire formats and on-disk indices. a catalog row may give
+// an explicit code instead; the generator rejects catalogs where two codes
+// collide
+
+enum error_severity {
+  error_severity_info,
+  error_severity_warning,
+  error_severity_error,
+  error_severity_fatal
+};
+
+struct error_descriptor {
+  error_value id;
+  uint32_t code;
+  unsigned char severity;
+  bool retryable;
+  const char *name;  // the identifier in the generated namespace, e.g. "eOPEN"
+};
+
+// FNV-1a over text, continuing from h to hash several strings as one
+inline uint32_t error_stable_code(const char *text, uint32_t h = 2166136261u) {
+  for (; text && *text; ++text) {
+    h ^= static_cast<unsigned char>(*text);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// the stable code of a catalog row without an explicit one: FNV-1a over
+// "GROUP-PACKAGE::name"
+inline uint32_t error_catalog_code(const char *group, const char *package, const char *name) {
+  uint32_t h = error_stable_code(group);
+  h = error_stable_code("-", h);
+  h = error_stable_code(package, h);
+  h = error_stable_code("::", h);
+  return error_stable_code(name, h);
+}
+
+// the hash used by the generated index, shared with the generator so the two
+// cannot disagree: seed 0 picks the bucket, the bucket's displacement
+// (1 upwards) is then the seed picking the slot
+inline uint32_t error_catalog_hash(uint32_t code, uint32_t seed) {
+  uint32_t h = code ^ (seed * 0x9E3779B9u);
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+struct error_catalog_index {
+  const uint32_t *displacements;
+  unsigned displacement_count;
+  const error_descriptor *const *slots;  // NULL where unused
+  unsigned slot_count;
+};
+
+class error_catalog {
+public:
+  // registers each descriptor's id with error_registry and records it
+  static void add(const error_descriptor *descriptors, unsigned count);
+
+  // adds a generated stable code index, returns false if there are too many
+  static bool add_index(const error_catalog_index *index);
+
+  // the descriptor of a catalogued error_id, NULL otherwise
+  static const error_descriptor *find(error_value id);
+
+  // the descriptor with the given stable code, NULL if none is catalogued
+  static const error_descriptor *find_code(uint32_t code);
+
+  // the catalogued code of id, or for uncatalogued ids the hash of its text
+  static uint32_t code_of(error_value id);
+
+  static const unsigned max_indices = 16;
+};
+
+// used by the generated code to register itself during static initialisation
+class error_catalog_registration {
+public:
+  error_catalog_registration(const error_descriptor *descriptors, unsigned count) {
+    error_catalog::add(descriptors, count);
+  }
+
+  explicit error_catalog_registration(const error_catalog_index *index) { error_catalog::add_index(index); }
+};
+
+#endif /* ERROR_CATALOG_HPP_ */
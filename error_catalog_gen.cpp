@@ -0,0 +1,396 @@
+/*
+ * error_catalog_gen.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// generates error_id definitions from a tab separated catalog (the format
+// is in error_catalog_tsv.hpp):
+//
+//   # group  package  name   message              severity  retryable  code
+//   GRP      CAT      eOPEN  Cannot open catalog  error     yes
+//
+// severity is one of info, warning, error (the default) or fatal
+//
+// the stable code is error_catalog_code of group, package and name, so
+// rewording a message never changes it; the optional code column (decimal or
+// 0x hex) pins it instead, for renames or to settle a collision
+//
+// for each group/package pair GRP_PKG_errors.h and GRP_PKG_errors.cpp hold
+// the error_ids (in namespace GRP_PKG), their stable codes and descriptor
+// table, and a relocation free table of error_refs to the ids (which are
+// placed in the error_ids section, see error_handle.hpp);
+// error_catalog_index.cpp holds the perfect hash from stable code to
+// descriptor, and catalog.mk tells make about all of them
+// files are only rewritten when their content changes, so editing one
+// package only recompiles that package (and the small index)
+//
+// usage: error_catalog_gen catalog.tsv output_dir
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "error_catalog.hpp"
+#include "error_catalog_tsv.hpp"
+
+namespace {
+
+struct entry {
+  std::string name;
+  std::string message;
+  std::string text;  // as SCOPE_ERROR would produce it
+  std::string severity;
+  bool retryable;
+  uint32_t code;
+  unsigned package;
+  unsigned position;  // within its package's descriptor table
+  unsigned line;
+};
+
+struct package {
+  std::string group;
+  std::string name;
+  std::string ns;
+  std::vector<unsigned> entries;
+};
+
+struct catalog {
+  std::string source;
+  std::vector<entry> entries;
+  std::vector<package> packages;
+};
+
+void fail(const std::string &message) {
+  std::fprintf(stderr, "error_catalog_gen: %s\n", message.c_str());
+  std::exit(1);
+}
+
+std::string at_line(const catalog &c, unsigned line) {
+  std::ostringstream os;
+  os << c.source << ":" << line;
+  return os.str();
+}
+
+bool is_identifier(const std::string &s) {
+  if (s.empty() || (s[0] >= '0' && s[0] <= '9')) {
+    return false;
+  }
+  for (std::string::size_type i = 0; i < s.size(); ++i) {
+    char ch = s[i];
+    if (!((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// a C string literal with the same content
+std::string quoted(const std::string &s) {
+  std::string out = "\"";
+  for (std::string::size_type i = 0; i < s.size(); ++i) {
+    if (s[i] == '"' || s[i] == '\\') {
+      out += '\\';
+    }
+    out += s[i];
+  }
+  return out + "\"";
+}
+
+std::string hex(uint32_t value) {
+  char buf[16];
+  std::snprintf(buf, sizeof(buf), "0x%08Xu", value);
+  return buf;
+}
+
+catalog read_catalog(const char *path) {
+  std::ifstream in(path);
+  if (!in) {
+    fail(std::string("cannot read ") + path);
+  }
+  catalog c;
+  c.source = path;
+  std::map<std::string, unsigned> packages;
+  std::map<std::string, unsigned> names;
+  std::map<uint32_t, unsigned> codes;
+
+  std::string line;
+  std::vector<std::string> fields;
+  for (unsigned number = 1; std::getline(in, line); ++number) {
+    if (!error_catalog_fields(line, fields)) {
+      continue;
+    }
+    if (fields.size() < error_catalog_min_columns || fields.size() > error_catalog_max_columns) {
+      fail(at_line(c, number) + ": expected group, package, name, message[, severity[, retryable[, code]]]");
+    }
+    entry e;
+    e.name = fields[2];
+    e.message = fields[3];
+    e.text = fields[0] + "-" + fields[1] + ": " + fields[3];
+    e.severity = fields.size() > 4 && !fields[4].empty() ? fields[4] : "error";
+    std::string retryable = fields.size() > 5 ? fields[5] : "no";
+    e.retryable = retryable == "yes" || retryable == "true" || retryable == "1";
+    if (!error_catalog_row_code(fields, e.code)) {
+      fail(at_line(c, number) + ": code " + fields[error_catalog_code_column] + " is not a 32 bit number");
+    }
+    e.line = number;
+
+    if (e.severity != "info" && e.severity != "warning" && e.severity != "error" && e.severity != "fatal") {
+      fail(at_line(c, number) + ": unknown severity " + e.severity);
+    }
+    std::string ns = fields[0] + "_" + fields[1];
+    if (!is_identifier(ns) || !is_identifier(e.name)) {
+      fail(at_line(c, number) + ": group, package and name must make C++ identifiers");
+    }
+
+    std::map<std::string, unsigned>::iterator p = packages.find(ns);
+    if (p == packages.end()) {
+      package pkg;
+      pkg.group = fields[0];
+      pkg.name = fields[1];
+      pkg.ns = ns;
+      p = packages.insert(std::make_pair(ns, static_cast<unsigned>(c.packages.size()))).first;
+      c.packages.push_back(pkg);
+    }
+    e.package = p->second;
+    e.position = static_cast<unsigned>(c.packages[e.package].entries.size());
+
+    if (!names.insert(std::make_pair(ns + "::" + e.name, number)).second) {
+      fail(at_line(c, number) + ": " + ns + "::" + e.name + " is already defined");
+    }
+    std::map<uint32_t, unsigned>::iterator clash = codes.find(e.code);
+    if (clash != codes.end()) {
+      fail(at_line(c, number) + ": stable code " + hex(e.code) + " collides with line " + at_line(c, clash->second)
+           + ", give one of them an explicit code");
+    }
+    codes[e.code] = number;
+
+    c.packages[e.package].entries.push_back(static_cast<unsigned>(c.entries.size()));
+    c.entries.push_back(e);
+  }
+  return c;
+}
+
+// hash and displace: buckets are placed largest first, each trying
+// displacements until all its codes land in free slots
+struct perfect_hash {
+  std::vector<uint32_t> displacements;
+  std::vector<int> slots;  // entry index, -1 where unused
+};
+
+perfect_hash build_index(const catalog &c) {
+  perfect_hash ph;
+  unsigned n = static_cast<unsigned>(c.entries.size());
+  unsigned bucket_count = n / 4 + 1;
+  unsigned slot_count = n + n / 4 + 1;
+  ph.displacements.assign(bucket_count, 0);
+  ph.slots.assign(slot_count, -1);
+
+  std::vector<std::vector<unsigned> > buckets(bucket_count);
+  for (unsigned i = 0; i < n; ++i) {
+    buckets[error_catalog_hash(c.entries[i].code, 0) % bucket_count].push_back(i);
+  }
+  std::vector<unsigned> order(bucket_count);
+  for (unsigned b = 0; b < bucket_count; ++b) {
+    order[b] = b;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](unsigned a, unsigned b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  for (unsigned o = 0; o < bucket_count; ++o) {
+    const std::vector<unsigned> &bucket = buckets[order[o]];
+    if (bucket.empty()) {
+      break;
+    }
+    for (uint32_t d = 1;; ++d) {
+      if (d == 0) {
+        fail("no perfect hash found for the catalog");
+      }
+      std::vector<unsigned> placed;
+      bool fits = true;
+      for (unsigned k = 0; k < bucket.size() && fits; ++k) {
+        unsigned slot = error_catalog_hash(c.entries[bucket[k]].code, d) % slot_count;
+        fits = ph.slots[slot] < 0 && std::find(placed.begin(), placed.end(), slot) == placed.end();
+        placed.push_back(slot);
+      }
+      if (fits) {
+        for (unsigned k = 0; k < bucket.size(); ++k) {
+          ph.slots[placed[k]] = static_cast<int>(bucket[k]);
+        }
+        ph.displacements[order[o]] = d;
+        break;
+      }
+    }
+  }
+  return ph;
+}
+
+// the symbol name of an id, the same whatever the compiler's name mangling
+std::string symbol(const package &p, const entry &e) { return p.ns + "_id_" + e.name; }
+
+std::string banner(const std::string &file, const catalog &c) {
+  return "/*\n * " + file + "\n *\n *  generated by error_catalog_gen from " + c.source + " - do not edit\n */\n\n";
+}
+
+std::string package_header(const catalog &c, const package &p) {
+  std::string guard = p.ns + "_ERRORS_H_";
+  std::ostringstream os;
+  os << banner(p.ns + "_errors.h", c);
+  os << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+  os << "#include <stdint.h>\n\n";
+  os << "#include \"error_catalog.hpp\"\n#include \"error_handle.hpp\"\n#include \"error_id.hpp\"\n\n";
+  os << "namespace " << p.ns << " {\n";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    os << "  extern error_id " << e.name << " ERROR_ID_SYMBOL(\"" << symbol(p, e) << "\"); // " << e.severity
+       << (e.retryable ? ", retryable" : "") << "\n";
+  }
+  os << "\n  // stable codes, the same in every build\n  namespace codes {\n";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    os << "    const uint32_t " << e.name << " = " << hex(e.code) << ";\n";
+  }
+  os << "  }\n\n";
+  os << "  extern const error_descriptor descriptors[];\n";
+  os << "  const unsigned descriptor_count = " << p.entries.size() << ";\n";
+  os << "}\n\n";
+  os << "#if ERROR_ID_HAS_HANDLES\n// the ids again, in descriptor order, without relocations\n";
+  os << "extern \"C\" const error_ref " << p.ns << "_refs[];\n#endif\n\n#endif /* " << guard << " */\n";
+  return os.str();
+}
+
+std::string package_source(const catalog &c, const package &p) {
+  static const char *const severities[] = { "error_severity_info", "error_severity_warning", "error_severity_error",
+                                            "error_severity_fatal" };
+  std::ostringstream os;
+  os << banner(p.ns + "_errors.cpp", c);
+  os << "#include \"" << p.ns << "_errors.h\"\n\n";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    os << "ERROR_ID_SECTION error_id " << p.ns << "::" << e.name << " = SCOPE_ERROR(" << quoted(p.group) << ", " << quoted(p.name)
+       << ", " << quoted(e.message) << ");\n";
+  }
+  os << "\nconst error_descriptor " << p.ns << "::descriptors[] = {\n";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    unsigned severity = e.severity == "info" ? 0 : e.severity == "warning" ? 1 : e.severity == "error" ? 2 : 3;
+    os << "  { " << p.ns << "::" << e.name << ", " << hex(e.code) << ", " << severities[severity] << ", "
+       << (e.retryable ? "true" : "false") << ", " << quoted(e.name) << " },\n";
+  }
+  os << "};\n\n";
+  os << "static error_catalog_registration registration(" << p.ns << "::descriptors, " << p.ns
+     << "::descriptor_count);\n\n";
+
+  // each entry is "id - ." which the static linker resolves, naming the ids
+  // through local aliases of the symbols the header gives them: the ids
+  // themselves may be preempted in a shared object, so a reference to them
+  // could not be resolved statically, one to a local alias is made against
+  // the section instead
+  os << "#if ERROR_ID_HAS_HANDLES\n";
+  os << "asm(";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    os << (i ? "    " : "") << "\".set .L" << symbol(p, e) << ", " << symbol(p, e) << "\\n\"\n";
+  }
+  os << "    \".pushsection .rodata." << p.ns << "_refs, \\\"a\\\"\\n\"\n";
+  os << "    \".balign 4\\n\"\n";
+  os << "    \".globl " << p.ns << "_refs\\n\"\n";
+  os << "    \".hidden " << p.ns << "_refs\\n\"\n";
+  os << "    \"" << p.ns << "_refs:\\n\"\n";
+  for (unsigned i = 0; i < p.entries.size(); ++i) {
+    const entry &e = c.entries[p.entries[i]];
+    os << "    \".long .L" << symbol(p, e) << " - .\\n\"\n";
+  }
+  os << "    \".popsection\\n\");\n#endif\n";
+  return os.str();
+}
+
+std::string index_source(const catalog &c, const perfect_hash &ph) {
+  std::ostringstream os;
+  os << banner("error_catalog_index.cpp", c);
+  os << "#include \"error_catalog.hpp\"\n\n";
+  for (unsigned p = 0; p < c.packages.size(); ++p) {
+    os << "#include \"" << c.packages[p].ns << "_errors.h\"\n";
+  }
+  os << "\nnamespace {\n\nconst uint32_t displacements[] = {";
+  for (unsigned i = 0; i < ph.displacements.size(); ++i) {
+    os << (i % 8 ? " " : "\n  ") << ph.displacements[i] << "u,";
+  }
+  os << "\n};\n\nconst error_descriptor *const slots[] = {";
+  for (unsigned i = 0; i < ph.slots.size(); ++i) {
+    if (ph.slots[i] < 0) {
+      os << "\n  NULL,";
+    } else {
+      const entry &e = c.entries[ph.slots[i]];
+      os << "\n  &" << c.packages[e.package].ns << "::descriptors[" << e.position << "],";
+    }
+  }
+  os << "\n};\n\n";
+  os << "const error_catalog_index index = { displacements, " << ph.displacements.size() << ", slots, "
+     << ph.slots.size() << " };\n\n";
+  os << "error_catalog_registration registration(&index);\n\n}\n";
+  return os.str();
+}
+
+std::string makefile_fragment(const catalog &c, const std::string &dir) {
+  std::ostringstream os;
+  os << "# generated by error_catalog_gen from " << c.source << " - do not edit\n\n";
+  os << "CATALOG_HEADERS =";
+  for (unsigned p = 0; p < c.packages.size(); ++p) {
+    os << " " << dir << "/" << c.packages[p].ns << "_errors.h";
+  }
+  os << "\n\nCATALOG_OBJS =";
+  for (unsigned p = 0; p < c.packages.size(); ++p) {
+    os << " " << dir << "/" << c.packages[p].ns << "_errors.o";
+  }
+  os << " " << dir << "/error_catalog_index.o\n\n";
+  for (unsigned p = 0; p < c.packages.size(); ++p) {
+    os << dir << "/" << c.packages[p].ns << "_errors.o: " << dir << "/" << c.packages[p].ns << "_errors.h\n";
+  }
+  os << dir << "/error_catalog_index.o: $(CATALOG_HEADERS)\n";
+  return os.str();
+}
+
+// leaves the file (and its timestamp) alone when nothing has changed
+void write_if_changed(const std::string &path, const std::string &content) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (in) {
+    std::ostringstream existing;
+    existing << in.rdbuf();
+    if (existing.str() == content) {
+      return;
+    }
+  }
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  out << content;
+  if (!out) {
+    fail("cannot write " + path);
+  }
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: error_catalog_gen catalog.tsv output_dir\n");
+    return 2;
+  }
+  std::string dir = argv[2];
+  catalog c = read_catalog(argv[1]);
+  perfect_hash ph = build_index(c);
+
+  for (unsigned p = 0; p < c.packages.size(); ++p) {
+    write_if_changed(dir + "/" + c.packages[p].ns + "_errors.h", package_header(c, c.packages[p]));
+    write_if_changed(dir + "/" + c.packages[p].ns + "_errors.cpp", package_source(c, c.packages[p]));
+  }
+  write_if_changed(dir + "/error_catalog_index.cpp", index_source(c, ph));
+  write_if_changed(dir + "/catalog.mk", makefile_fragment(c, dir));
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * error_catalog_tsv.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_CATALOG_TSV_HPP_
+#define ERROR_CATALOG_TSV_HPP_
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "error_catalog.hpp"
+
+// the catalog file format, read by error_catalog_gen and log_input alike:
+// one error per line, tab separated
+//
+//   group  package  name  message[  severity[  retryable[  code]]]
+//
+// blank lines and lines starting with # are skipped, and a trailing \r is
+// dropped so catalogs edited on Windows read the same
+
+enum error_catalog_column {
+  error_catalog_group,
+  error_catalog_package,
+  error_catalog_name,
+  error_catalog_message,
+  error_catalog_severity,
+  error_catalog_retryable,
+  error_catalog_code_column
+};
+
+const unsigned error_catalog_min_columns = error_catalog_severity;
+const unsigned error_catalog_max_columns = error_catalog_code_column + 1;
+
+// the fields of line, false for a line to skip; a row with too few or too
+// many fields is left to the caller, which knows how to complain
+inline bool error_catalog_fields(std::string line, std::vector<std::string> &fields) {
+  fields.clear();
+  if (!line.empty() && line[line.size() - 1] == '\r') {
+    line.erase(line.size() - 1);
+  }
+  if (line.empty() || line[0] == '#') {
+    return false;
+  }
+  std::string::size_type start = 0;
+  for (;;) {
+    std::string::size_type tab = line.find('\t', start);
+    fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+    if (tab == std::string::npos) {
+      return true;
+    }
+    start = tab + 1;
+  }
+}
+
+// the stable code of a row: its code column (decimal or 0x hex) if given,
+// else error_catalog_code of its group, package and name; false if the
+// column is not a 32 bit number
+inline bool error_catalog_row_code(const std::vector<std::string> &fields, uint32_t &code) {
+  if (fields.size() <= error_catalog_code_column || fields[error_catalog_code_column].empty()) {
+    code = error_catalog_code(fields[error_catalog_group].c_str(), fields[error_catalog_package].c_str(),
+                              fields[error_catalog_name].c_str());
+    return true;
+  }
+  const std::string &column = fields[error_catalog_code_column];
+  char *end = NULL;
+  unsigned long long value = std::strtoull(column.c_str(), &end, 0);
+  if (*end || column[0] < '0' || column[0] > '9' || value > 0xFFFFFFFFull) {
+    return false;
+  }
+  code = static_cast<uint32_t>(value);
+  return true;
+}
+
+#endif /* ERROR_CATALOG_TSV_HPP_ */
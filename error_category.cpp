@@ -0,0 +1,17 @@
+/*
+ * error_category.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_category.hpp"
+
+// std::error_category's constructor is constexpr, so this is constant
+// initialised and usable from other translation units' static initialisers
+const error_id_category error_id_category::instance_;
+
+std::string error_id_category::message(int value) const {
+  error_value id = error_registry::at(static_cast<unsigned>(value));
+  return id ? std::string(id) : std::string("unregistered error_id");
+}
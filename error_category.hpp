@@ -0,0 +1,58 @@
+/*
+ * error_category.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_CATEGORY_HPP_
+#define ERROR_CATEGORY_HPP_
+
+#include <string>
+#include <system_error>
+
+#include "error_id.hpp"
+#include "error_registry.hpp"
+
+// error_values as std::error_codes, for APIs that take those: one category
+// for every error_id, the value being the id's registry index, so the way
+// back is an array lookup and the value 0 of "no error" is NULL here too
+//
+//   void connect(std::error_code &ec);
+//
+//   std::error_code ec = error_id_category::make(FooErrors::eFOO);
+//   error_value err = error_id_category::id(ec);    // FooErrors::eFOO
+//
+// message() has to return a std::string, so it copies the id text; id()
+// gives the text itself where that is all that is needed
+
+class error_id_category : public std::error_category {
+public:
+  // the one instance: std::error_codes compare categories by address
+  static const error_id_category &instance() { return instance_; }
+
+  // registers id on first sight; NULL gives the empty std::error_code, and
+  // an id the full registry cannot take is error_code(-1, instance())
+  static std::error_code make(error_value id) {
+    if (!id) {
+      return std::error_code();
+    }
+    unsigned index = error_registry::add(id);
+    return std::error_code(index ? static_cast<int>(index) : -1, instance_);
+  }
+
+  // the error_value of a code made by make(), NULL for any other
+  static error_value id(const std::error_code &code) {
+    return &code.category() == &instance_ ? error_registry::at(static_cast<unsigned>(code.value())) : NULL;
+  }
+
+  const char *name() const noexcept override { return "error_id"; }
+  std::string message(int value) const override;
+
+private:
+  constexpr error_id_category() {}
+
+  static const error_id_category instance_;
+};
+
+#endif /* ERROR_CATEGORY_HPP_ */
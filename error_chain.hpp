@@ -0,0 +1,135 @@
+/*
+ * error_chain.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_CHAIN_HPP_
+#define ERROR_CHAIN_HPP_
+
+#if __cplusplus < 201703L
+#error "error_chain.hpp requires C++17 (std::pmr)"
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+// a chain of causes, each an error_id plus a short context string, allocated
+// from a caller supplied memory resource
+// the nodes are trivially destructible and are never deallocated one by one:
+// the resource is expected to be a monotonic arena scoped to the request, so
+// the whole chain is discarded by a single release() of that arena
+
+struct error_cause {
+  error_value id;
+  const char *context;      // NBTS held in the same allocation as the node
+  std::size_t context_len;
+  const error_cause *next;  // the cause of this error, NULL at the root
+};
+
+class error_chain {
+public:
+  explicit error_chain(std::pmr::memory_resource *resource) : resource_(resource), head_(NULL), size_(0) {}
+
+  // records id as the new outermost error, caused by the existing chain
+  const error_cause &push(error_value id, std::string_view context = std::string_view()) {
+    void *mem = resource_->allocate(sizeof(error_cause) + context.size() + 1, alignof(error_cause));
+    char *text = static_cast<char *>(mem) + sizeof(error_cause);
+    std::memcpy(text, context.data(), context.size());
+    text[context.size()] = '\0';
+    error_cause *cause = ::new (mem) error_cause;
+    cause->id = id;
+    cause->context = text;
+    cause->context_len = context.size();
+    cause->next = head_;
+    head_ = cause;
+    ++size_;
+    return *cause;
+  }
+
+  // the outermost cause, follow next to reach the root
+  const error_cause *head() const { return head_; }
+
+  // the outermost error_id, NULL for an empty chain
+  error_value id() const { return head_ ? head_->id : NULL; }
+
+  // the innermost (original) error_id, NULL for an empty chain
+  error_value root() const {
+    const error_cause *cause = head_;
+    while (cause && cause->next) {
+      cause = cause->next;
+    }
+    return cause ? cause->id : NULL;
+  }
+
+  bool contains(error_value id) const {
+    for (const error_cause *cause = head_; cause; cause = cause->next) {
+      if (cause->id == id) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool empty() const { return head_ == NULL; }
+  std::size_t size() const { return size_; }
+
+  // forgets the causes, their memory returns with the resource's release()
+  void clear() {
+    head_ = NULL;
+    size_ = 0;
+  }
+
+  std::pmr::memory_resource *resource() const { return resource_; }
+
+private:
+  std::pmr::memory_resource *resource_;
+  const error_cause *head_;
+  std::size_t size_;
+};
+
+// a request scoped arena: the first N bytes come from inline storage, any
+// overflow from upstream, and reset() discards everything at once
+template <std::size_t N> class error_chain_arena {
+public:
+  explicit error_chain_arena(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : resource_(buffer_, N, upstream) {}
+
+  error_chain_arena(const error_chain_arena &) = delete;
+  error_chain_arena &operator=(const error_chain_arena &) = delete;
+
+  std::pmr::memory_resource *resource() { return &resource_; }
+
+  void reset() { resource_.release(); }
+
+private:
+  alignas(std::max_align_t) char buffer_[N];
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+// a typed error which also carries the causes which led to it
+// the chain refers into the arena, so it must not outlive the request
+template <error_id errtype> class chained_error : public typed_error_lite<errtype> {
+public:
+  explicit chained_error(const error_chain &causes) : causes_(causes) {}
+
+  const error_chain &causes() const { return causes_; }
+
+  // the context of the outermost cause where there is one
+  const char *what() const noexcept {
+    const error_cause *head = causes_.head();
+    return head && head->context_len ? head->context : errtype;
+  }
+
+private:
+  error_chain causes_;
+};
+
+#endif /* ERROR_CHAIN_HPP_ */
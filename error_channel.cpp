@@ -0,0 +1,96 @@
+/*
+ * error_channel.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_channel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+namespace {
+
+const unsigned cache_line = 64;
+
+}
+
+error_channel::error_channel(size_t capacity) : tail_(0), head_(0), refused_(0), mask_(0), storage_(NULL), slots_(NULL) {
+  size_t slots = 2;
+  while (slots < capacity) {
+    slots *= 2;
+  }
+  mask_ = slots - 1;
+  storage_ = ::operator new(slots * sizeof(slot_type) + cache_line);
+  uintptr_t aligned = (reinterpret_cast<uintptr_t>(storage_) + cache_line - 1) & ~static_cast<uintptr_t>(cache_line - 1);
+  slots_ = reinterpret_cast<slot_type *>(aligned);
+  // slot i is free for the sender claiming position i
+  for (size_t i = 0; i < slots; ++i) {
+    new (&slots_[i].sequence) std::atomic<uint64_t>(i);
+  }
+}
+
+error_channel::~error_channel() { ::operator delete(storage_); }
+
+bool error_channel::try_send(error_value err, const char *context, uint64_t time) {
+  uint64_t position = tail_.load(std::memory_order_relaxed);
+  slot_type *slot;
+  for (;;) {
+    slot = &slots_[position & mask_];
+    uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    int64_t lag = static_cast<int64_t>(sequence - position);
+    if (lag == 0) {
+      if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (lag < 0) {
+      // the slot still holds the message from a lap ago
+      refused_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->error = err;
+  slot->time = time;
+  size_t length = 0;
+  if (context) {
+    length = std::min(std::strlen(context), error_message::context_size - 1);
+    std::memcpy(slot->context, context, length);
+  }
+  slot->context[length] = '\0';
+  slot->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+size_t error_channel::receive(error_message *out, size_t max) {
+  uint64_t position = head_.load(std::memory_order_relaxed);
+  size_t n = 0;
+  for (; n < max; ++n, ++position) {
+    slot_type &slot = slots_[position & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      break;
+    }
+    out[n].error = slot.error;
+    out[n].time = slot.time;
+    std::memcpy(out[n].context, slot.context, error_message::context_size);
+    // free for the sender a lap ahead
+    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+  }
+  head_.store(position, std::memory_order_relaxed);
+  return n;
+}
+
+size_t error_channel::size() const {
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
+
+uint64_t error_channel::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
@@ -0,0 +1,92 @@
+/*
+ * error_channel.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_CHANNEL_HPP_
+#define ERROR_CHANNEL_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// carries failures from any number of worker threads to one supervisor
+//
+// a bounded ring of one cache line messages, each slot with a sequence
+// number saying whose turn it is (D. Vyukov's bounded queue): a sender
+// claims a slot with one CAS on the tail and publishes it with a release
+// store, the receiver owns the head outright, so neither side takes a lock
+// and nothing is allocated after construction
+//
+// when the ring is full try_send() refuses at once rather than waiting; the
+// sender decides whether to retry, drop or slow down, and congested() says
+// when to start slowing down before it comes to that
+//
+//   worker:      if (!channel.try_send(err, "table orders")) { ... }
+//   supervisor:  error_message batch[64];
+//                size_t n = channel.receive(batch, 64);
+
+struct error_message {
+  static const size_t context_size = 40;
+
+  error_value error;
+  uint64_t time;                // error_channel::now() when sent
+  char context[context_size];   // NUL terminated, cut short if need be
+};
+
+class error_channel {
+public:
+  // capacity is rounded up to a power of two
+  explicit error_channel(size_t capacity = 1024);
+  ~error_channel();
+
+  // any thread: false, counting it in refused(), if the channel is full
+  bool try_send(error_value err, const char *context = NULL) { return try_send(err, context, now()); }
+  bool try_send(error_value err, const char *context, uint64_t time);
+
+  // the receiving thread only: moves up to max messages, oldest first,
+  // into out and returns how many
+  size_t receive(error_message *out, size_t max);
+  bool try_receive(error_message &out) { return receive(&out, 1) == 1; }
+
+  size_t capacity() const { return static_cast<size_t>(mask_ + 1); }
+
+  // messages waiting, exact only while no thread is using the channel
+  size_t size() const;
+
+  // at least three quarters full
+  bool congested() const { return size() >= capacity() - capacity() / 4; }
+
+  // sends refused for want of room since construction
+  uint64_t refused() const { return refused_.load(std::memory_order_relaxed); }
+
+  // the steady clock in ns
+  static uint64_t now();
+
+private:
+  error_channel(const error_channel &);
+  error_channel &operator=(const error_channel &);
+
+  struct slot_type {
+    std::atomic<uint64_t> sequence;
+    error_value error;
+    uint64_t time;
+    char context[error_message::context_size];
+  };
+
+  // senders and the receiver each write their own cache line
+  std::atomic<uint64_t> tail_;
+  char tail_padding[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> head_;
+  char head_padding[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> refused_;
+  uint64_t mask_;
+  void *storage_;
+  slot_type *slots_;
+};
+
+#endif /* ERROR_CHANNEL_HPP_ */
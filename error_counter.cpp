@@ -0,0 +1,37 @@
+/*
+ * error_counter.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_counter.hpp"
+
+#include <atomic>
+
+#include "error_registry.hpp"
+
+namespace {
+
+// constant initialised, so counting from static initialisers is safe
+std::atomic<uint64_t> counts[error_registry::max_ids + 1];
+
+}
+
+uint64_t error_counter::add(error_value id, uint64_t n) {
+  unsigned index = error_registry::add(id);
+  if (index == 0) {
+    return 0;
+  }
+  return counts[index].fetch_add(n, std::memory_order_relaxed) + n;
+}
+
+uint64_t error_counter::count(error_value id) {
+  return counts[error_registry::index_of(id)].load(std::memory_order_relaxed);
+}
+
+void error_counter::reset() {
+  for (unsigned index = 0; index <= error_registry::max_ids; ++index) {
+    counts[index].store(0, std::memory_order_relaxed);
+  }
+}
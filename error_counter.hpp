@@ -0,0 +1,32 @@
+/*
+ * error_counter.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_COUNTER_HPP_
+#define ERROR_COUNTER_HPP_
+
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// process wide occurrence counts per error_id, kept in a plain array
+// indexed by the registry index: add() is a registry lookup and a relaxed
+// atomic add, never a lock once the id has been seen
+
+class error_counter {
+public:
+  // counts n occurrences of id, registering it on first sight, and returns
+  // the new count (0 for NULL, or when the registry is full)
+  static uint64_t add(error_value id, uint64_t n = 1);
+
+  // the occurrences of id counted so far
+  static uint64_t count(error_value id);
+
+  // sets every count back to 0
+  static void reset();
+};
+
+#endif /* ERROR_COUNTER_HPP_ */
@@ -0,0 +1,88 @@
+/*
+ * error_handle.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_HANDLE_HPP_
+#define ERROR_HANDLE_HPP_
+
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// in a position independent executable or shared library every stored
+// pointer to an error_id is a dynamic relocation: ld.so has to patch it at
+// startup, and the page holding it is dirtied (.data.rel.ro) rather than
+// shared - for tables of thousands of ids that is a measurable cost
+//
+// error_handle is a 32 bit offset from the start of the error_ids section,
+// plus one so that 0 (the default) is the handle of NULL, no error; holding
+// one needs no relocation, and converting to and from error_value is an add
+// or subtract and a test for 0. ids opt in to the section with ERROR_ID_SECTION
+// (the catalog generator does this for every catalogued id):
+//
+//   ERROR_ID_SECTION error_id eFOO = SCOPE_ERROR("GRP", "PKG", "Foo");
+//
+// each module (executable or shared library) has its own section, so a
+// handle is only meaningful in the module defining the id - use error_value
+// across module boundaries
+//
+// error_ref is the building block for constant tables: a 32 bit offset
+// from the entry itself to the id, resolved by the static linker, so an
+// array of them is relocation free too. C++ cannot express the initialiser,
+// so they are emitted in assembler (see error_catalog_gen); ids referred to
+// there are declared with ERROR_ID_SYMBOL, giving them a plain symbol name
+// in place of the compiler's mangled one
+
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#define ERROR_ID_HAS_HANDLES 1
+#define ERROR_ID_SECTION __attribute__((section("error_ids")))
+#define ERROR_ID_SYMBOL(name) __asm__(name)
+
+// provided by the linker for any section whose name is an identifier
+extern "C" const char __start_error_ids[] __attribute__((weak, visibility("hidden")));
+#else
+#define ERROR_ID_HAS_HANDLES 0
+#define ERROR_ID_SECTION
+#define ERROR_ID_SYMBOL(name)
+#endif
+
+#if ERROR_ID_HAS_HANDLES
+
+class error_handle {
+public:
+  // no error
+  error_handle() : offset_(0) {}
+
+  explicit error_handle(uint32_t offset) : offset_(offset) {}
+
+  // id must be NULL or defined with ERROR_ID_SECTION in this module
+  static error_handle of(error_value id) {
+    return error_handle(id ? static_cast<uint32_t>(id - __start_error_ids) + 1 : 0);
+  }
+
+  // NULL for the default handle
+  error_value value() const { return offset_ ? __start_error_ids + offset_ - 1 : NULL; }
+
+  uint32_t offset() const { return offset_; }
+
+  bool operator==(const error_handle &other) const { return offset_ == other.offset_; }
+  bool operator!=(const error_handle &other) const { return offset_ != other.offset_; }
+
+private:
+  uint32_t offset_;
+};
+
+struct error_ref {
+  int32_t offset;
+
+  error_value value() const { return reinterpret_cast<const char *>(this) + offset; }
+
+  error_handle handle() const { return error_handle::of(value()); }
+};
+
+#endif
+
+#endif /* ERROR_HANDLE_HPP_ */
@@ -0,0 +1,97 @@
+/*
+ * error_id.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_ID_H_
+#define ERROR_ID_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// the C interface to the error_id support code, built as
+// Default/liberrorid.a and Default/liberrorid.so ("make liberrorid"):
+// the registry, stable codes, counters and the flight recorder, and the
+// last error slot of error_last.hpp
+//
+//   static error_id eOPEN = SCOPE_ERROR("DB", "TBL", "cannot open table");
+//
+//   if (open_table(name) < 0) {
+//     error_id_counter_add(eOPEN, 1);
+//     error_id_record(eOPEN, name);
+//   }
+//
+// each call is the C++ implementation itself, so the same lock-free paths
+// are taken; C++ code may use either
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// see error_registry.hpp: dense indices from 1, 0 for "not registered"
+unsigned error_id_register(error_value id);
+unsigned error_id_index(error_value id);
+error_value error_id_at(unsigned index);
+unsigned error_id_registered(void);
+
+// the stable code of an id, see error_catalog.hpp
+uint32_t error_id_code(error_value id);
+
+// the id with a stable code: catalogued ids are found by a hash lookup,
+// otherwise registered ids are searched one by one; NULL if none has it
+error_value error_id_find_code(uint32_t code);
+
+// see error_counter.hpp
+uint64_t error_id_counter_add(error_value id, uint64_t n);
+uint64_t error_id_counter_get(error_value id);
+void error_id_counters_reset(void);
+
+// see error_recorder.hpp, the layout is that of error_record
+struct error_id_entry {
+  error_value error;
+  uint64_t time;
+  uint32_t thread;
+  char context[40];
+};
+
+void error_id_record(error_value err, const char *context);
+size_t error_id_recorder_snapshot(struct error_id_entry *out, size_t max);
+uint64_t error_id_recorder_dropped(void);
+
+// see error_last.hpp
+void error_last_set(const char *err, const char *context);
+const char *error_last_get(void);
+const char *error_last_context(void);
+void error_last_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// error_id_last() reads the last error inline from C, as error_last::get()
+// does from C++, where the compiler supports __thread; define
+// ERROR_LAST_INITIAL_EXEC as for error_last.hpp
+#ifndef __cplusplus
+#if defined(__GNUC__) || defined(__clang__)
+struct error_last_slot {
+  error_value error;
+  char context[64];
+};
+
+#if defined(ERROR_LAST_INITIAL_EXEC)
+extern __thread __attribute__((tls_model("initial-exec"))) struct error_last_slot error_last_tls;
+#else
+extern __thread struct error_last_slot error_last_tls;
+#endif
+
+static inline error_value error_id_last(void) { return error_last_tls.error; }
+#else
+static inline error_value error_id_last(void) { return error_last_get(); }
+#endif
+#endif
+
+#endif /* ERROR_ID_H_ */
@@ -0,0 +1,63 @@
+/*
+ * error_id_c.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_id.h"
+
+#include <stddef.h>
+
+#include "error_catalog.hpp"
+#include "error_counter.hpp"
+#include "error_last.hpp"
+#include "error_recorder.hpp"
+#include "error_registry.hpp"
+
+// error_id.h repeats these layouts for C
+static_assert(sizeof(error_id_entry) == sizeof(error_record) && offsetof(error_id_entry, time) == offsetof(error_record, time) &&
+                  offsetof(error_id_entry, thread) == offsetof(error_record, thread) &&
+                  offsetof(error_id_entry, context) == offsetof(error_record, context) &&
+                  sizeof(error_id_entry().context) == error_record::context_size,
+              "error_id_entry must match error_record");
+static_assert(error_last_slot::context_size == 64 && sizeof(error_last_slot) == sizeof(error_value) + 64,
+              "error_id.h must match error_last_slot");
+
+unsigned error_id_register(error_value id) { return error_registry::add(id); }
+
+unsigned error_id_index(error_value id) { return error_registry::index_of(id); }
+
+error_value error_id_at(unsigned index) { return error_registry::at(index); }
+
+unsigned error_id_registered(void) { return error_registry::size(); }
+
+uint32_t error_id_code(error_value id) { return error_catalog::code_of(id); }
+
+error_value error_id_find_code(uint32_t code) {
+  const error_descriptor *descriptor = error_catalog::find_code(code);
+  if (descriptor) {
+    return descriptor->id;
+  }
+  for (unsigned index = 1, count = error_registry::size(); index <= count; ++index) {
+    error_value id = error_registry::at(index);
+    if (error_catalog::code_of(id) == code) {
+      return id;
+    }
+  }
+  return NULL;
+}
+
+uint64_t error_id_counter_add(error_value id, uint64_t n) { return error_counter::add(id, n); }
+
+uint64_t error_id_counter_get(error_value id) { return error_counter::count(id); }
+
+void error_id_counters_reset(void) { error_counter::reset(); }
+
+void error_id_record(error_value err, const char *context) { error_recorder::record(err, context); }
+
+size_t error_id_recorder_snapshot(error_id_entry *out, size_t max) {
+  return error_recorder::snapshot(reinterpret_cast<error_record *>(out), max);
+}
+
+uint64_t error_id_recorder_dropped(void) { return error_recorder::dropped(); }
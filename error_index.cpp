@@ -0,0 +1,450 @@
+/*
+ * error_index.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_index.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char magic[8] = { 'E', 'R', 'R', 'I', 'D', 'X', '\1', '\0' };
+
+struct segment_header {
+  char magic[8];
+  uint64_t bytes;
+  uint32_t file_count;
+  uint32_t code_count;
+  uint64_t files;  // offsets from the start of the segment
+  uint64_t codes;
+  uint64_t postings;
+};
+
+// followed by the path, padded to 8 bytes
+struct file_entry {
+  uint32_t id;
+  uint32_t path_bytes;
+  uint64_t device;
+  uint64_t inode;
+  uint64_t begin;
+  uint64_t end;
+};
+
+struct code_entry {
+  uint32_t code;
+  uint32_t reserved;
+  uint64_t count;
+  int64_t first_time;
+  uint64_t postings;  // offset from the segment's postings
+  uint64_t bytes;
+};
+
+const int64_t no_time = -1;
+
+size_t padded(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+
+void put_varint(std::string &out, uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+// false, leaving v as it was, for a varint running past end or 64 bits
+bool get_varint(const unsigned char *&p, const unsigned char *end, uint64_t &v) {
+  uint64_t value = 0;
+  for (unsigned shift = 0; p != end && shift < 64; shift += 7) {
+    unsigned char byte = *p++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      v = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+template <typename T> void put(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+bool write_all(int fd, const std::string &data) {
+  const char *p = data.data();
+  size_t left = data.size();
+  while (left) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    p += n;
+    left -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+const segment_header *header(const char *segment) { return reinterpret_cast<const segment_header *>(segment); }
+
+// whether the tables the header points at lie within the segment, so a
+// damaged header ends the readable index like a torn one does
+bool well_formed(const char *segment) {
+  const segment_header *h = header(segment);
+  uint64_t bytes = h->bytes;
+  if (h->files > bytes || h->files % 8 || h->codes > bytes || h->codes % 8 || h->postings > bytes
+      || h->code_count > (bytes - h->codes) / sizeof(code_entry)) {
+    return false;
+  }
+  uint64_t at = h->files;
+  for (uint32_t i = 0; i < h->file_count; ++i) {
+    if (bytes - at < sizeof(file_entry)) {
+      return false;
+    }
+    const file_entry *e = reinterpret_cast<const file_entry *>(segment + at);
+    at += sizeof(file_entry);
+    if (bytes - at < padded(e->path_bytes)) {
+      return false;
+    }
+    at += padded(e->path_bytes);
+  }
+  uint64_t postings = bytes - h->postings;
+  const code_entry *c = reinterpret_cast<const code_entry *>(segment + h->codes);
+  for (uint32_t i = 0; i < h->code_count; ++i) {
+    if (c[i].postings > postings || c[i].bytes > postings - c[i].postings) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const code_entry *find_code(const char *segment, uint32_t code) {
+  const segment_header *h = header(segment);
+  const code_entry *begin = reinterpret_cast<const code_entry *>(segment + h->codes);
+  const code_entry *end = begin + h->code_count;
+  const code_entry *c = std::lower_bound(begin, end, code, [](const code_entry &e, uint32_t value) {
+    return e.code < value;
+  });
+  return c != end && c->code == code ? c : NULL;
+}
+
+void add_totals(error_index_code &total, const code_entry &c) {
+  total.count += c.count;
+  if (c.first_time != no_time && (total.first_time == no_time || c.first_time < total.first_time)) {
+    total.first_time = c.first_time;
+  }
+}
+
+}
+
+bool error_index_writer::entry::operator<(const entry &other) const {
+  if (code != other.code) {
+    return code < other.code;
+  }
+  if (posting.file != other.posting.file) {
+    return posting.file < other.posting.file;
+  }
+  return posting.offset < other.posting.offset;
+}
+
+void error_index_writer::add(uint32_t code, const error_posting &posting) {
+  entry e = { code, posting };
+  postings_.push_back(e);
+}
+
+error_index_lock::error_index_lock(const char *path) : fd_(-1) {
+  for (;;) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+      return;
+    }
+    int locked;
+    do {
+      locked = flock(fd, LOCK_EX);
+    } while (locked != 0 && errno == EINTR);
+    struct stat held;
+    struct stat named;
+    if (locked != 0 || fstat(fd, &held) != 0) {
+      int saved = errno;
+      close(fd);
+      errno = saved;
+      return;
+    }
+    // compact() renames a new index over the one locked here
+    if (stat(path, &named) == 0 && named.st_dev == held.st_dev && named.st_ino == held.st_ino) {
+      fd_ = fd;
+      return;
+    }
+    close(fd);
+  }
+}
+
+error_index_lock::~error_index_lock() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+bool error_index_writer::append_to(const char *path) {
+  error_index_lock lock(path);
+  if (!lock.ok()) {
+    return false;
+  }
+  return append_to(path, lock);
+}
+
+bool error_index_writer::append_to(const char *path, const error_index_lock &held) {
+  std::sort(postings_.begin(), postings_.end());
+
+  std::string files;
+  for (size_t i = 0; i < files_.size(); ++i) {
+    const error_index_file &f = files_[i];
+    file_entry e = { f.id, static_cast<uint32_t>(f.path.size()), f.device, f.inode, f.begin, f.end };
+    put(files, e);
+    files.append(f.path);
+    files.append(padded(f.path.size()) - f.path.size(), '\0');
+  }
+
+  std::string codes;
+  std::string postings;
+  for (size_t i = 0; i < postings_.size();) {
+    code_entry c = { postings_[i].code, 0, 0, no_time, postings.size(), 0 };
+    uint32_t file = 0;
+    uint64_t offset = 0;
+    int64_t time = 0;
+    for (; i < postings_.size() && postings_[i].code == c.code; ++i) {
+      const error_posting &p = postings_[i].posting;
+      if (p.file != file) {
+        offset = 0;
+      }
+      put_varint(postings, p.file - file);
+      put_varint(postings, p.offset - offset);
+      put_varint(postings, zigzag(p.time - time));
+      file = p.file;
+      offset = p.offset;
+      time = p.time;
+      ++c.count;
+      if (p.time != no_time && (c.first_time == no_time || p.time < c.first_time)) {
+        c.first_time = p.time;
+      }
+    }
+    c.bytes = postings.size() - c.postings;
+    put(codes, c);
+  }
+  postings.append(padded(postings.size()) - postings.size(), '\0');
+
+  segment_header h;
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.file_count = static_cast<uint32_t>(files_.size());
+  h.code_count = static_cast<uint32_t>(codes.size() / sizeof(code_entry));
+  h.files = sizeof(h);
+  h.codes = h.files + files.size();
+  h.postings = h.codes + codes.size();
+  h.bytes = h.postings + postings.size();
+  std::string segment;
+  segment.reserve(h.bytes);
+  put(segment, h);
+  segment += files;
+  segment += codes;
+  segment += postings;
+
+  // anything after the last complete segment is a failed append, replaced
+  uint64_t valid;
+  {
+    error_index_reader existing(path);
+    if (!existing.ok()) {
+      return false;
+    }
+    valid = existing.valid_bytes();
+  }
+  int fd = held.fd_;
+  bool written = ftruncate(fd, static_cast<off_t>(valid)) == 0 && lseek(fd, 0, SEEK_END) >= 0
+                 && write_all(fd, segment) && fsync(fd) == 0;
+  if (written) {
+    files_.clear();
+    postings_.clear();
+  }
+  return written;
+}
+
+error_index_reader::error_index_reader(const char *path) : data_(NULL), size_(0), ok_(false), valid_bytes_(0) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    ok_ = errno == ENOENT;
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) == 0) {
+    ok_ = true;
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_) {
+      void *data = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {
+        ok_ = false;
+        size_ = 0;
+      } else {
+        data_ = static_cast<const char *>(data);
+      }
+    }
+  }
+  close(fd);
+
+  while (valid_bytes_ + sizeof(segment_header) <= size_) {
+    const char *segment = data_ + valid_bytes_;
+    const segment_header *h = header(segment);
+    if (std::memcmp(h->magic, magic, sizeof(magic)) || h->bytes < sizeof(segment_header)
+        || h->bytes > size_ - valid_bytes_ || h->bytes % 8 || !well_formed(segment)) {
+      break;
+    }
+    segments_.push_back(segment);
+    valid_bytes_ += h->bytes;
+  }
+}
+
+error_index_reader::~error_index_reader() {
+  if (data_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+}
+
+std::vector<error_index_file> error_index_reader::files() const {
+  std::vector<error_index_file> all;
+  for (size_t s = 0; s < segments_.size(); ++s) {
+    const char *p = segments_[s] + header(segments_[s])->files;
+    for (uint32_t i = 0; i < header(segments_[s])->file_count; ++i) {
+      const file_entry *e = reinterpret_cast<const file_entry *>(p);
+      error_index_file f;
+      f.id = e->id;
+      f.device = e->device;
+      f.inode = e->inode;
+      f.begin = e->begin;
+      f.end = e->end;
+      f.path.assign(p + sizeof(file_entry), e->path_bytes);
+      all.push_back(f);
+      p += sizeof(file_entry) + padded(e->path_bytes);
+    }
+  }
+  return all;
+}
+
+std::vector<error_index_file> error_index_reader::latest_files() const {
+  std::vector<error_index_file> all = files();
+  std::vector<error_index_file> latest(next_file_id());
+  for (size_t i = 0; i < all.size(); ++i) {
+    // an id of 0xFFFFFFFF wraps next_file_id() round to 0
+    if (all[i].id < latest.size()) {
+      latest[all[i].id] = all[i];
+    }
+  }
+  return latest;
+}
+
+uint32_t error_index_reader::next_file_id() const {
+  std::vector<error_index_file> all = files();
+  uint32_t next = 0;
+  for (size_t i = 0; i < all.size(); ++i) {
+    next = std::max(next, all[i].id + 1);
+  }
+  return next;
+}
+
+void error_index_reader::find(uint32_t code, std::vector<error_posting> &postings) const {
+  for (size_t s = 0; s < segments_.size(); ++s) {
+    const code_entry *c = find_code(segments_[s], code);
+    if (!c) {
+      continue;
+    }
+    const unsigned char *p
+        = reinterpret_cast<const unsigned char *>(segments_[s] + header(segments_[s])->postings + c->postings);
+    const unsigned char *end = p + c->bytes;
+    error_posting posting = { 0, 0, 0 };
+    for (uint64_t i = 0; i < c->count; ++i) {
+      // a count larger than the postings stops at their end
+      uint64_t file_delta, offset_delta, time_delta;
+      if (!get_varint(p, end, file_delta) || !get_varint(p, end, offset_delta) || !get_varint(p, end, time_delta)) {
+        break;
+      }
+      if (file_delta) {
+        posting.offset = 0;
+      }
+      posting.file += static_cast<uint32_t>(file_delta);
+      posting.offset += offset_delta;
+      posting.time += unzigzag(time_delta);
+      postings.push_back(posting);
+    }
+  }
+}
+
+error_index_code error_index_reader::summary(uint32_t code) const {
+  error_index_code total = { code, 0, no_time };
+  for (size_t s = 0; s < segments_.size(); ++s) {
+    const code_entry *c = find_code(segments_[s], code);
+    if (c) {
+      add_totals(total, *c);
+    }
+  }
+  return total;
+}
+
+std::vector<error_index_code> error_index_reader::codes() const {
+  std::map<uint32_t, error_index_code> totals;
+  for (size_t s = 0; s < segments_.size(); ++s) {
+    const code_entry *c = reinterpret_cast<const code_entry *>(segments_[s] + header(segments_[s])->codes);
+    for (uint32_t i = 0; i < header(segments_[s])->code_count; ++i) {
+      error_index_code empty = { c[i].code, 0, no_time };
+      add_totals(totals.insert(std::make_pair(c[i].code, empty)).first->second, c[i]);
+    }
+  }
+  std::vector<error_index_code> all;
+  for (std::map<uint32_t, error_index_code>::const_iterator i = totals.begin(); i != totals.end(); ++i) {
+    all.push_back(i->second);
+  }
+  return all;
+}
+
+bool error_index_reader::compact(const char *path) {
+  error_index_lock lock(path);
+  if (!lock.ok()) {
+    return false;
+  }
+  error_index_writer writer;
+  {
+    error_index_reader reader(path);
+    if (!reader.ok()) {
+      return false;
+    }
+    std::vector<error_index_file> files = reader.files();
+    for (size_t i = 0; i < files.size(); ++i) {
+      writer.add_file(files[i]);
+    }
+    std::vector<error_index_code> codes = reader.codes();
+    for (size_t i = 0; i < codes.size(); ++i) {
+      std::vector<error_posting> postings;
+      reader.find(codes[i].code, postings);
+      for (size_t p = 0; p < postings.size(); ++p) {
+        writer.add(codes[i].code, postings[p]);
+      }
+    }
+  }
+  // written beside the index and renamed over it, so readers see either
+  std::string compacted = std::string(path) + ".compact";
+  std::remove(compacted.c_str());
+  return writer.append_to(compacted.c_str()) && std::rename(compacted.c_str(), path) == 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * error_index.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_INDEX_HPP_
+#define ERROR_INDEX_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// an on-disk inverted index from stable error codes (error_catalog::code_of,
+// see error_catalog.hpp) to where they occur in log files
+//
+// the file is a sequence of immutable segments, each written by one
+// indexing run and appended to the end, so indexing logs as they grow or
+// rotate never rewrites what is there (compact() merges them when wanted)
+// a segment is laid out to be used in place from a read only mapping:
+//
+//   header       magic, total bytes, counts and offsets of the tables below
+//   files        the log files (or parts of them) indexed by the segment
+//   codes        sorted by code: occurrence count, first timestamp and
+//                where the code's postings are
+//   postings     per code, sorted by (file, offset), as varints of the
+//                file delta, the offset delta (from 0 on a new file) and
+//                the zigzagged timestamp delta
+//
+// all fields are in host byte order, and 8 byte aligned
+// a segment cut short (a crash while appending) ends the readable index,
+// and the next append replaces it
+
+struct error_posting {
+  uint32_t file;
+  uint64_t offset;  // of the line holding the occurrence
+  int64_t time;     // the line's timestamp, log_input::no_time if it had none
+};
+
+// a log file, or the part of it a segment covers
+struct error_index_file {
+  uint32_t id;  // shared by every segment covering the same file
+  uint64_t device;
+  uint64_t inode;
+  uint64_t begin;
+  uint64_t end;
+  std::string path;  // as it was named when indexed
+};
+
+struct error_index_code {
+  uint32_t code;
+  uint64_t count;
+  int64_t first_time;  // the earliest timestamp, log_input::no_time if none
+};
+
+// an exclusive flock() on the index file: writers hold it from reading
+// the index to appending to it, so two indexing runs on the same index
+// (two log rotation hooks, say) take turns rather than truncating or
+// interleaving each other's segments
+// the index is created if need be, and locked afresh if compact()
+// replaced it while waiting
+class error_index_lock {
+public:
+  explicit error_index_lock(const char *path);
+  ~error_index_lock();
+
+  // false, with errno set, if the index could not be locked
+  bool ok() const { return fd_ >= 0; }
+
+private:
+  friend class error_index_writer;
+
+  error_index_lock(const error_index_lock &);
+  error_index_lock &operator=(const error_index_lock &);
+
+  int fd_;
+};
+
+class error_index_writer {
+public:
+  void add_file(const error_index_file &file) { files_.push_back(file); }
+
+  void add(uint32_t code, const error_posting &posting);
+
+  bool empty() const { return files_.empty() && postings_.empty(); }
+
+  // appends a segment holding everything added, after the last complete
+  // segment of the index at path (creating it if need be), holding the
+  // index's lock meanwhile
+  // false, with errno set, if it could not be written
+  bool append_to(const char *path);
+
+  // the same under a lock the caller holds already, e.g. since reading
+  // latest_files() to decide what to add
+  bool append_to(const char *path, const error_index_lock &held);
+
+private:
+  struct entry {
+    uint32_t code;
+    error_posting posting;
+    bool operator<(const entry &other) const;
+  };
+
+  std::vector<error_index_file> files_;
+  std::vector<entry> postings_;
+};
+
+class error_index_reader {
+public:
+  // maps the index read only; ok() is false if it cannot be read
+  // a missing index reads as an empty one
+  explicit error_index_reader(const char *path);
+  ~error_index_reader();
+
+  bool ok() const { return ok_; }
+
+  // the number of complete segments, and the bytes they take
+  size_t segments() const { return segments_.size(); }
+  uint64_t valid_bytes() const { return valid_bytes_; }
+
+  // every file entry of every segment, oldest first
+  std::vector<error_index_file> files() const;
+
+  // the newest entry for each file id, indexed by id
+  std::vector<error_index_file> latest_files() const;
+
+  // the next unused file id
+  uint32_t next_file_id() const;
+
+  // appends code's postings from every segment, oldest segment first
+  void find(uint32_t code, std::vector<error_posting> &postings) const;
+
+  // the count and first timestamp of code over all segments, count 0 if
+  // it does not occur; only reads the code tables
+  error_index_code summary(uint32_t code) const;
+
+  // every code in the index with its totals, sorted by code
+  std::vector<error_index_code> codes() const;
+
+  // rewrites the index at path as a single segment
+  static bool compact(const char *path);
+
+private:
+  error_index_reader(const error_index_reader &);
+  error_index_reader &operator=(const error_index_reader &);
+
+  const char *data_;
+  size_t size_;
+  bool ok_;
+  uint64_t valid_bytes_;
+  std::vector<const char *> segments_;
+};
+
+#endif /* ERROR_INDEX_HPP_ */
@@ -0,0 +1,326 @@
+/*
+ * error_index_main.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// error_index: keeps an inverted index of the error_ids in log archives,
+// see error_index.hpp for the format
+//
+//   error_index add INDEX [options] file...   index new lines of the files
+//   error_index find INDEX [options] ID       when and where ID occurred
+//   error_index list INDEX [options]          every code, count, first seen
+//   error_index files INDEX                   the files indexed
+//   error_index compact INDEX                 merge the segments into one
+//
+// options: -j threads, -c catalog.tsv, -i ids.txt (as for error_scan) and
+// for find, -p to print every posting; ID is an id's text or its stable
+// code in hex (0x...)
+//
+// catalogued ids are indexed under their catalog code (see error_catalog.hpp),
+// so rewording a message does not orphan what was indexed before; other ids
+// under the hash of their text
+//
+// "add" remembers how far each file (by device and inode) was indexed, so
+// running it again after the log has grown indexes only the new complete
+// lines, and a log renamed by rotation is recognised as the same file;
+// a file that has shrunk (truncated in place) is indexed afresh
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "error_catalog.hpp"
+#include "error_id.hpp"
+#include "error_index.hpp"
+#include "error_scan.hpp"
+#include "log_input.hpp"
+
+namespace {
+
+const size_t chunk_bytes = 16 << 20;
+
+struct piece {
+  const char *data;  // the start of the file's mapping
+  const char *begin;
+  const char *end;
+  uint32_t file;
+};
+
+typedef std::vector<std::pair<uint32_t, error_posting> > found;
+
+// the stable code of each id text the tools know about
+typedef std::map<std::string, uint32_t> code_table;
+
+void fail(const std::string &message) {
+  std::fprintf(stderr, "error_index: %s\n", message.c_str());
+  std::exit(1);
+}
+
+void usage() {
+  std::fprintf(stderr, "usage: error_index add|find|list|files|compact INDEX [-j threads] [-c catalog.tsv] "
+                       "[-i ids.txt] [-p] [file...|ID]\n");
+  std::exit(2);
+}
+
+void scan_piece(const error_scanner &scanner, const std::map<error_value, uint32_t> &codes, const piece &p,
+                found &out) {
+  const char *line = NULL;
+  int64_t time = log_input::no_time;
+  scanner.scan(p.begin, p.end, [&](const char *match_end, error_value id) {
+    const char *start = match_end - std::strlen(id);
+    if (!line || std::memchr(line, '\n', start - line)) {
+      line = log_input::line_start(p.begin, start);
+      time = log_input::line_time(line, p.end);
+    }
+    error_posting posting = { p.file, static_cast<uint64_t>(line - p.data), time };
+    out.push_back(std::make_pair(codes.find(id)->second, posting));
+  });
+}
+
+int add(const char *index, const std::vector<error_value> &ids, const code_table &known_codes, unsigned threads,
+        const std::vector<const char *> &paths) {
+  // held throughout, so that what another run indexed meanwhile is known
+  error_index_lock lock(index);
+  if (!lock.ok()) {
+    fail(std::string("cannot lock ") + index + ": " + std::strerror(errno));
+  }
+  error_index_reader reader(index);
+  if (!reader.ok()) {
+    fail(std::string("cannot read ") + index);
+  }
+  std::vector<error_index_file> known = reader.latest_files();
+  uint32_t next_id = reader.next_file_id();
+
+  error_scanner scanner(ids);
+  std::map<error_value, uint32_t> codes;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    codes[ids[i]] = known_codes.find(ids[i])->second;
+  }
+
+  error_index_writer writer;
+  std::vector<piece> pieces;
+  for (size_t f = 0; f < paths.size(); ++f) {
+    struct stat st;
+    size_t size;
+    bool ok;
+    const char *data = log_input::map(paths[f], size, ok);
+    if (!ok || stat(paths[f], &st) != 0) {
+      fail(std::string("cannot read ") + paths[f]);
+    }
+
+    error_index_file file;
+    file.id = next_id;
+    file.device = st.st_dev;
+    file.inode = st.st_ino;
+    file.begin = 0;
+    file.path = paths[f];
+    for (size_t k = 0; k < known.size(); ++k) {
+      if (known[k].device == file.device && known[k].inode == file.inode && known[k].end <= size) {
+        file.id = known[k].id;
+        file.begin = known[k].end;
+      }
+    }
+    // only complete lines, the rest is picked up next time
+    file.end = file.begin;
+    for (size_t end = size; end > file.begin; --end) {
+      if (data[end - 1] == '\n') {
+        file.end = end;
+        break;
+      }
+    }
+    if (file.end == file.begin) {
+      continue;
+    }
+    if (file.id == next_id) {
+      ++next_id;
+    }
+    writer.add_file(file);
+
+    std::vector<const char *> cuts;
+    log_input::cut(data + file.begin, file.end - file.begin, chunk_bytes, cuts);
+    for (size_t i = 0; i < cuts.size(); i += 2) {
+      piece p = { data, cuts[i], cuts[i + 1], file.id };
+      pieces.push_back(p);
+    }
+  }
+  if (writer.empty()) {
+    return 0;
+  }
+
+  std::vector<found> results(pieces.size());
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.push_back(std::thread([&]() {
+      for (size_t p = next++; p < pieces.size(); p = next++) {
+        scan_piece(scanner, codes, pieces[p], results[p]);
+      }
+    }));
+  }
+  for (unsigned t = 0; t < threads; ++t) {
+    workers[t].join();
+  }
+  for (size_t p = 0; p < results.size(); ++p) {
+    for (size_t i = 0; i < results[p].size(); ++i) {
+      writer.add(results[p][i].first, results[p][i].second);
+    }
+  }
+  if (!writer.append_to(index, lock)) {
+    fail(std::string("cannot write ") + index + ": " + std::strerror(errno));
+  }
+  return 0;
+}
+
+uint32_t code_of(const code_table &known_codes, const char *id) {
+  if (id[0] == '0' && (id[1] == 'x' || id[1] == 'X')) {
+    return static_cast<uint32_t>(std::strtoul(id, NULL, 16));
+  }
+  code_table::const_iterator known = known_codes.find(id);
+  return known != known_codes.end() ? known->second : error_stable_code(id);
+}
+
+int find(const error_index_reader &reader, const code_table &known_codes, const char *id, bool every) {
+  uint32_t code = code_of(known_codes, id);
+  std::vector<error_posting> postings;
+  reader.find(code, postings);
+  std::vector<error_index_file> files = reader.latest_files();
+
+  error_index_code summary = reader.summary(code);
+  std::printf("code\t0x%08X\noccurrences\t%llu\nfirst seen\t%s\n", code,
+              static_cast<unsigned long long>(summary.count), log_input::format_time(summary.first_time).c_str());
+
+  // per file: occurrences, first and last timestamps and the first offset
+  std::map<uint32_t, std::pair<uint64_t, error_posting> > first;
+  std::map<uint32_t, int64_t> last;
+  for (size_t i = 0; i < postings.size(); ++i) {
+    const error_posting &p = postings[i];
+    std::pair<uint64_t, error_posting> &f = first.insert(std::make_pair(p.file, std::make_pair(0, p))).first->second;
+    ++f.first;
+    int64_t &latest = last.insert(std::make_pair(p.file, log_input::no_time)).first->second;
+    latest = std::max(latest, p.time);
+    if (every) {
+      std::printf("%s\t%llu\t%s\n", files[p.file].path.c_str(), static_cast<unsigned long long>(p.offset),
+                  log_input::format_time(p.time).c_str());
+    }
+  }
+  for (std::map<uint32_t, std::pair<uint64_t, error_posting> >::const_iterator i = first.begin(); i != first.end();
+       ++i) {
+    std::printf("file\t%s\t%llu occurrences\tfirst at byte %llu\t%s .. %s\n", files[i->first].path.c_str(),
+                static_cast<unsigned long long>(i->second.first),
+                static_cast<unsigned long long>(i->second.second.offset),
+                log_input::format_time(i->second.second.time).c_str(), log_input::format_time(last[i->first]).c_str());
+  }
+  return summary.count ? 0 : 1;
+}
+
+int list(const error_index_reader &reader, const code_table &known_codes) {
+  std::map<uint32_t, std::string> names;
+  for (code_table::const_iterator i = known_codes.begin(); i != known_codes.end(); ++i) {
+    names.insert(std::make_pair(i->second, i->first));
+  }
+  std::vector<error_index_code> codes = reader.codes();
+  for (size_t i = 0; i < codes.size(); ++i) {
+    std::map<uint32_t, std::string>::const_iterator name = names.find(codes[i].code);
+    std::printf("0x%08X\t%llu\t%s\t%s\n", codes[i].code, static_cast<unsigned long long>(codes[i].count),
+                log_input::format_time(codes[i].first_time).c_str(), name == names.end() ? "?" : name->second.c_str());
+  }
+  return 0;
+}
+
+int files(const error_index_reader &reader) {
+  std::vector<error_index_file> all = reader.files();
+  for (size_t i = 0; i < all.size(); ++i) {
+    std::printf("%u\t%llu..%llu\t%s\n", all[i].id, static_cast<unsigned long long>(all[i].begin),
+                static_cast<unsigned long long>(all[i].end), all[i].path.c_str());
+  }
+  return 0;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    usage();
+  }
+  std::string command = argv[1];
+  const char *index = argv[2];
+  unsigned threads = std::thread::hardware_concurrency();
+  bool every = false;
+  std::vector<error_value> ids;
+  log_input::registered_ids(ids);
+  std::vector<uint32_t> codes;  // parallel to ids, until the -i ids
+  for (size_t i = 0; i < ids.size(); ++i) {
+    codes.push_back(error_catalog::code_of(ids[i]));
+  }
+  std::vector<error_value> plain_ids;
+  std::vector<const char *> operands;
+
+  for (int arg = 3; arg < argc; ++arg) {
+    std::string option = argv[arg];
+    if (option == "-p") {
+      every = true;
+    } else if (arg + 1 < argc && option == "-j") {
+      threads = std::atoi(argv[++arg]);
+    } else if (arg + 1 < argc && option == "-c") {
+      if (!log_input::read_catalog(argv[++arg], ids, &codes)) {
+        fail(std::string("cannot read ") + argv[arg]);
+      }
+    } else if (arg + 1 < argc && option == "-i") {
+      if (!log_input::read_ids(argv[++arg], plain_ids)) {
+        fail(std::string("cannot read ") + argv[arg]);
+      }
+    } else {
+      operands.push_back(argv[arg]);
+    }
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  // an id text is known by the first code given for it, the hash of the text
+  // only for ids neither registered nor in a catalog
+  code_table known_codes;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    known_codes.insert(std::make_pair(std::string(ids[i]), codes[i]));
+  }
+  for (size_t i = 0; i < plain_ids.size(); ++i) {
+    known_codes.insert(std::make_pair(std::string(plain_ids[i]), error_stable_code(plain_ids[i])));
+    ids.push_back(plain_ids[i]);
+  }
+
+  if (command == "add") {
+    return add(index, ids, known_codes, threads, operands);
+  }
+  if (command == "compact") {
+    if (!error_index_reader::compact(index)) {
+      fail(std::string("cannot compact ") + index);
+    }
+    return 0;
+  }
+  error_index_reader reader(index);
+  if (!reader.ok()) {
+    fail(std::string("cannot read ") + index);
+  }
+  if (command == "find" && operands.size() == 1) {
+    return find(reader, known_codes, operands[0], every);
+  }
+  if (command == "list") {
+    return list(reader, known_codes);
+  }
+  if (command == "files") {
+    return files(reader);
+  }
+  usage();
+  return 2;
+}
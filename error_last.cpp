@@ -0,0 +1,47 @@
+/*
+ * error_last.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_last.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+ERROR_LAST_TLS error_last_slot error_last_tls;
+
+const size_t error_last_slot::context_size;
+
+void error_last::set(error_value err, const char *context) {
+  error_last_slot &slot = error_last_tls;
+  slot.error = err;
+  size_t length = 0;
+  if (context) {
+    length = std::strlen(context);
+    if (length >= error_last_slot::context_size) {
+      length = error_last_slot::context_size - 1;
+    }
+    std::memcpy(slot.context, context, length);
+  }
+  slot.context[length] = '\0';
+}
+
+void error_last::setf(error_value err, const char *format, ...) {
+  error_last_slot &slot = error_last_tls;
+  slot.error = err;
+  va_list args;
+  va_start(args, format);
+  std::vsnprintf(slot.context, error_last_slot::context_size, format, args);
+  va_end(args);
+}
+
+void error_last_set(const char *err, const char *context) { error_last::set(err, context); }
+
+const char *error_last_get(void) { return error_last::get(); }
+
+const char *error_last_context(void) { return error_last::context(); }
+
+void error_last_clear(void) { error_last::clear(); }
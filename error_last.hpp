@@ -0,0 +1,97 @@
+/*
+ * error_last.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_LAST_HPP_
+#define ERROR_LAST_HPP_
+
+#include <stddef.h>
+
+#include "error_id.hpp"
+
+// an errno for error_values: a thread local slot holding the last error
+// and a short context, so functions following the C convention of
+// returning -1 can still say exactly what went wrong
+//
+//   int open_table(const char *name) {
+//     if (!exists(name)) {
+//       return error_last::fail(GRP_DB::eNO_TABLE, name);
+//     }
+//     ...
+//   }
+//
+//   if (open_table("orders") < 0) {
+//     log(error_last::get(), error_last::context());
+//   }
+//
+// set() and get() are a store and a load of the slot, inlined; from a
+// shared library (or code linked against one) the default TLS model still
+// calls __tls_get_addr for each access. Defining ERROR_LAST_INITIAL_EXEC
+// (everywhere the header is used) makes it a thread pointer relative
+// access instead, at the cost that a library built so may fail to
+// dlopen() once the static TLS space is used up - fine for libraries
+// linked at startup, which is the usual case
+
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(ERROR_LAST_INITIAL_EXEC)
+#define ERROR_LAST_TLS __thread __attribute__((tls_model("initial-exec")))
+#else
+#define ERROR_LAST_TLS __thread
+#endif
+#else
+#define ERROR_LAST_TLS thread_local
+#endif
+
+struct error_last_slot {
+  static const size_t context_size = 64;
+
+  error_value error;
+  char context[context_size];  // NUL terminated, cut short if need be
+};
+
+extern ERROR_LAST_TLS error_last_slot error_last_tls;
+
+class error_last {
+public:
+  static void set(error_value err) {
+    error_last_tls.error = err;
+    error_last_tls.context[0] = '\0';
+  }
+
+  // context is copied, and cut to fit
+  static void set(error_value err, const char *context);
+
+  // context formatted as by printf
+  static void setf(error_value err, const char *format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+      __attribute__((format(printf, 2, 3)))
+#endif
+      ;
+
+  // set(), then the -1 of the C convention
+  static int fail(error_value err, const char *context = NULL) {
+    set(err, context);
+    return -1;
+  }
+
+  static void clear() { set(NULL); }
+
+  // NULL if no error was set since the last clear()
+  static error_value get() { return error_last_tls.error; }
+
+  // empty if none was given
+  static const char *context() { return error_last_tls.context; }
+};
+
+// the same for C callers
+extern "C" {
+void error_last_set(const char *err, const char *context);
+const char *error_last_get(void);
+const char *error_last_context(void);
+void error_last_clear(void);
+}
+
+#endif /* ERROR_LAST_HPP_ */
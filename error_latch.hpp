@@ -0,0 +1,98 @@
+/*
+ * error_latch.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_LATCH_HPP_
+#define ERROR_LATCH_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+#include "error_id.hpp"
+
+// "first error wins" for parallel sub-operations: the first non-NULL
+// error_value set is kept, by a single CAS of the pointer, and everyone
+// else can see the outcome is decided and stop
+//
+// should_cancel() is one relaxed load of a line that is only written once,
+// so polling it in an inner loop costs next to nothing; keep the latch
+// away from data the tasks write, or the polls will miss in cache
+
+class error_latch {
+public:
+  error_latch() : first_(NULL) {}
+
+  // keeps err if no error was kept before; true if this call kept it
+  bool set(error_value err) {
+    error_value expected = NULL;
+    return err && first_.compare_exchange_strong(expected, err, std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+  // whether an error has been kept, for tasks to bail out early
+  bool should_cancel() const { return first_.load(std::memory_order_relaxed) != NULL; }
+
+  // the error kept, NULL if none
+  error_value get() const { return first_.load(std::memory_order_acquire); }
+
+  // for reuse, once no task is running
+  void reset() { first_.store(NULL, std::memory_order_relaxed); }
+
+private:
+  error_latch(const error_latch &);
+  error_latch &operator=(const error_latch &);
+
+  std::atomic<error_value> first_;
+};
+
+// runs task(i, latch) for i in [0, tasks) on up to threads threads (the
+// caller's included, 0 for one per core) and returns the first error any
+// of them returned, NULL if all succeeded
+// once an error is kept no further task is started, and running tasks may
+// poll latch.should_cancel() to stop early; what they return then is lost
+// tasks must not throw - wrap them in error_boundary if they might
+//
+//   error_value err = error_fork_join::run(parts.size(), [&](size_t i, const error_latch &latch) {
+//     return load(parts[i], latch);
+//   });
+
+class error_fork_join {
+public:
+  template <typename F> static error_value run(size_t tasks, F task, unsigned threads = 0) {
+    error_latch latch;
+    return run(tasks, task, latch, threads);
+  }
+
+  // with a latch of the caller's, which may already be set to cancel
+  template <typename F> static error_value run(size_t tasks, F task, error_latch &latch, unsigned threads = 0) {
+    if (threads == 0) {
+      threads = std::thread::hardware_concurrency();
+    }
+    if (threads > tasks) {
+      threads = static_cast<unsigned>(tasks);
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+      workers.push_back(std::thread([&]() { work(tasks, task, latch, next); }));
+    }
+    work(tasks, task, latch, next);
+    for (size_t t = 0; t < workers.size(); ++t) {
+      workers[t].join();
+    }
+    return latch.get();
+  }
+
+private:
+  template <typename F> static void work(size_t tasks, F &task, error_latch &latch, std::atomic<size_t> &next) {
+    for (size_t i = next++; i < tasks && !latch.should_cancel(); i = next++) {
+      latch.set(task(i, const_cast<const error_latch &>(latch)));
+    }
+  }
+};
+
+#endif /* ERROR_LATCH_HPP_ */
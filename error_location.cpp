@@ -0,0 +1,146 @@
+/*
+ * error_location.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_location.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+// the next ':' followed by a digit in [p, end), end if there is none
+const char *next_candidate(const char *p, const char *end) {
+#if defined(__SSE2__)
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i below_zero = _mm_set1_epi8('0' - 1);
+  const __m128i above_nine = _mm_set1_epi8('9' + 1);
+  // the second load reads one byte further on
+  while (end - p > 16) {
+    __m128i here = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i after = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(after, below_zero), _mm_cmplt_epi8(after, above_nine));
+    unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(here, colon), digit));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+  for (; end - p > 1; ++p) {
+    if (*p == ':' && is_digit(p[1])) {
+      return p;
+    }
+  }
+  return end;
+}
+
+// reads ":line GRP-PKG: " from colon, returning where the message starts
+// or NULL if it is not there
+const char *tail(const char *colon, const char *end, error_location &where) {
+  const char *p = colon + 1;
+  unsigned line = 0;
+  unsigned digits = 0;
+  for (; p != end && is_digit(*p); ++p) {
+    // no __LINE__ has 10 digits, and 9 cannot overflow
+    if (++digits > 9) {
+      return NULL;
+    }
+    line = line * 10 + (*p - '0');
+  }
+  if (p == end || *p != ' ') {
+    return NULL;
+  }
+  const char *group = ++p;
+  for (; p != end && *p != '-'; ++p) {
+    if (*p == ' ' || *p == ':') {
+      return NULL;
+    }
+  }
+  if (p == end || p == group) {
+    return NULL;
+  }
+  const char *group_end = p;
+  const char *package = ++p;
+  for (; p != end && *p != ':'; ++p) {
+    if (*p == ' ') {
+      return NULL;
+    }
+  }
+  if (end - p < 2 || p == package || p[1] != ' ') {
+    return NULL;
+  }
+  where.line = line;
+  where.group.data = group;
+  where.group.size = group_end - group;
+  where.package.data = package;
+  where.package.size = p - package;
+  return p + 2;
+}
+
+void set(error_span &span, const char *begin, const char *end) {
+  span.data = begin;
+  span.size = end - begin;
+}
+
+}
+
+bool error_span::operator==(const char *text) const {
+  return std::strlen(text) == size && std::memcmp(data, text, size) == 0;
+}
+
+bool error_location::parse(const char *text, size_t size, error_location &where) {
+  const char *end = text + size;
+  for (const char *c = next_candidate(text, end); c != end; c = next_candidate(c + 1, end)) {
+    const char *message = c == text ? NULL : tail(c, end, where);
+    if (message) {
+      set(where.file, text, c);
+      set(where.message, message, message != end && end[-1] == ' ' ? end - 1 : end);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool error_location::parse(error_value id, error_location &where) {
+  return id && parse(id, std::strlen(id), where);
+}
+
+const char *error_location::find(const char *begin, const char *end, error_location &where) {
+  for (const char *c = next_candidate(begin, end); c != end; c = next_candidate(c + 1, end)) {
+    const char *file = c;
+    while (file != begin && !std::strchr("\n \t[(\"", file[-1])) {
+      --file;
+    }
+    if (file == c) {
+      continue;
+    }
+    const char *line_end = static_cast<const char *>(std::memchr(c, '\n', end - c));
+    if (!line_end) {
+      line_end = end;
+    }
+    const char *message = tail(c, line_end, where);
+    if (!message) {
+      continue;
+    }
+    const char *message_end = line_end;
+    if (message_end != message && message_end[-1] == '\r') {
+      --message_end;
+    }
+    if (message_end != message && message_end[-1] == ' ') {
+      --message_end;
+    }
+    set(where.file, file, c);
+    set(where.message, message, message_end);
+    return line_end;
+  }
+  return NULL;
+}
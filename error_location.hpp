@@ -0,0 +1,63 @@
+/*
+ * error_location.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_LOCATION_HPP_
+#define ERROR_LOCATION_HPP_
+
+#include <stddef.h>
+#include <string>
+
+#include "error_id.hpp"
+
+// splits the text of SCOPE_ERROR_LOCATION back into its parts
+//
+//   "src/foo.cpp:42 GRP-FOO: Foo not Bar "
+//    file        line group package message
+//
+// the fields point into the text, nothing is copied; the candidates for
+// the ":line " after the file are found with SSE2, 16 bytes at a time
+//
+// __FILE__ is taken as it is, so it may hold spaces, '-', drive letters
+// and ':' (none but the line's is followed by digits and a space); where
+// the text could be read more than one way the first ":line GRP-PKG: "
+// wins. The group is everything up to the first '-', the package up to
+// the ": " and neither may be empty or hold a space or ':'
+//
+//   error_location where;
+//   if (error_location::parse(err, where)) {
+//     log(where.file.str(), where.line, where.message.str());
+//   }
+
+struct error_span {
+  const char *data;
+  size_t size;
+
+  std::string str() const { return std::string(data, size); }
+  bool operator==(const char *text) const;
+  bool operator!=(const char *text) const { return !(*this == text); }
+};
+
+struct error_location {
+  error_span file;
+  unsigned line;
+  error_span group;
+  error_span package;
+  error_span message;  // without the macro's trailing space
+
+  // the whole of [text, text + size) as one location, false if it is not
+  static bool parse(const char *text, size_t size, error_location &where);
+  static bool parse(error_value id, error_location &where);
+
+  // the first location in a log: the message runs to the end of its line
+  // (less a '\r' and the trailing space) and the file starts after the
+  // last space, tab, '[', '(' or '"' before it on the line, so a path with
+  // spaces is cut to its last part - only parse() takes any path
+  // returns the end of the location's line, NULL if there is none
+  static const char *find(const char *begin, const char *end, error_location &where);
+};
+
+#endif /* ERROR_LOCATION_HPP_ */
@@ -0,0 +1,116 @@
+/*
+ * error_log_limit.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_log_limit.hpp"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+
+namespace {
+
+const unsigned cache_line = 64;
+
+// the GCRA times saturate rather than wrap, and the tolerance stays below
+// this horizon, so an arrival time stuck at the top refuses everything
+const uint64_t horizon = UINT64_MAX / 2;
+
+inline uint64_t saturating_add(uint64_t a, uint64_t b) { return a > UINT64_MAX - b ? UINT64_MAX : a + b; }
+
+inline uint64_t saturating_mul(uint64_t a, uint64_t b) { return b && a > UINT64_MAX / b ? UINT64_MAX : a * b; }
+
+// a century, beyond which an interval counts as never
+const double longest_interval = 100 * 365.25 * 86400 * 1e9;
+
+uint64_t interval_for(double rate) {
+  if (!(rate > 0) || 1e9 / rate > longest_interval) {
+    return 0;
+  }
+  uint64_t interval = static_cast<uint64_t>(1e9 / rate);
+  return interval ? interval : 1;
+}
+
+}
+
+error_log_limiter::error_log_limiter(double rate, unsigned burst, unsigned sample_every, unsigned capacity)
+    : interval_(interval_for(rate))
+    , tolerance_(0)
+    , burst_(burst ? burst : 1)
+    , sample_every_(sample_every)
+    , capacity_(capacity)
+    , storage_(NULL)
+    , slots_(NULL) {
+  tolerance_ = saturating_mul(interval_, burst_);
+  if (tolerance_ > horizon) {
+    tolerance_ = horizon;
+  }
+  storage_ = ::operator new(static_cast<size_t>(capacity_) * sizeof(slot_type) + cache_line);
+  uintptr_t aligned = (reinterpret_cast<uintptr_t>(storage_) + cache_line - 1) & ~static_cast<uintptr_t>(cache_line - 1);
+  slots_ = reinterpret_cast<slot_type *>(aligned);
+  for (unsigned i = 0; i < capacity_; ++i) {
+    new (&slots_[i].arrival) std::atomic<uint64_t>(0);
+    new (&slots_[i].limited) std::atomic<uint64_t>(0);
+    new (&slots_[i].suppressed) std::atomic<uint64_t>(0);
+  }
+}
+
+error_log_limiter::~error_log_limiter() { ::operator delete(storage_); }
+
+bool error_log_limiter::allow(error_value id, uint64_t now_ns) {
+  unsigned index = error_registry::add(id);
+  if (index == 0 || index > capacity_) {
+    return true;
+  }
+  slot_type &s = slot(index);
+  uint64_t arrival = s.arrival.load(std::memory_order_relaxed);
+  if (interval_ == 0) {
+    // never replenished: arrival counts the lines of the burst instead
+    while (arrival < burst_) {
+      if (s.arrival.compare_exchange_weak(arrival, arrival + 1, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  } else {
+    for (;;) {
+      uint64_t next = saturating_add(arrival > now_ns ? arrival : now_ns, interval_);
+      if (next - now_ns > tolerance_) {
+        break;
+      }
+      if (s.arrival.compare_exchange_weak(arrival, next, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  uint64_t limited = s.limited.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (sample_every_ && limited % sample_every_ == 0) {
+    return true;
+  }
+  s.suppressed.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+uint64_t error_log_limiter::suppressed(error_value id) const {
+  unsigned index = error_registry::index_of(id);
+  if (index == 0 || index > capacity_) {
+    return 0;
+  }
+  return slot(index).suppressed.load(std::memory_order_relaxed);
+}
+
+size_t error_log_limiter::summary(error_value id, uint64_t count, char *buf, size_t len) {
+  int written = snprintf(buf, len, "%s \xC3\x97%llu suppressed", id ? id : "(null)", static_cast<unsigned long long>(count));
+  if (written < 0) {
+    return 0;
+  }
+  return static_cast<size_t>(written) < len ? static_cast<size_t>(written) : len - 1;
+}
+
+uint64_t error_log_limiter::now() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
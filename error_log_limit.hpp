@@ -0,0 +1,90 @@
+/*
+ * error_log_limit.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_LOG_LIMIT_HPP_
+#define ERROR_LOG_LIMIT_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "error_id.hpp"
+#include "error_registry.hpp"
+
+// per error_id rate limiting of log lines, consulted before formatting:
+//   if (limiter.allow(err)) log(err, ...);
+// each id gets a token bucket of rate lines per second with the given burst,
+// kept as a single "theoretical arrival time" word updated by CAS (GCRA), so
+// callers never take a lock; occurrences refused are counted, and optionally
+// one in sample_every of them is let through anyway
+// a rate of 0 (or one so low that a line is due less than once a century)
+// allows each id its burst and nothing after that
+// flush() reports the refused counts as one line per id:
+//   GRP-FOO: Foo not Bar ×48211 suppressed
+
+class error_log_limiter {
+public:
+  // tracks ids whose registry index is at most capacity, others always pass
+  error_log_limiter(double rate, unsigned burst, unsigned sample_every = 0, unsigned capacity = 1024);
+  ~error_log_limiter();
+
+  // true if this occurrence of id should be logged, registering id on first sight
+  bool allow(error_value id) { return allow(id, now()); }
+  bool allow(error_value id, uint64_t now_ns);
+
+  // occurrences refused since the last flush
+  uint64_t suppressed(error_value id) const;
+
+  // hands sink one summary line for each id with suppressed occurrences,
+  // resetting their counts; returns the number of lines
+  template <typename Sink> unsigned flush(Sink sink) {
+    char line[summary_max];
+    unsigned lines = 0;
+    unsigned last = error_registry::size() < capacity_ ? error_registry::size() : capacity_;
+    for (unsigned index = 1; index <= last; ++index) {
+      uint64_t count = slot(index).suppressed.exchange(0, std::memory_order_relaxed);
+      if (count) {
+        summary(error_registry::at(index), count, line, sizeof(line));
+        sink(static_cast<const char *>(line));
+        ++lines;
+      }
+    }
+    return lines;
+  }
+
+  // formats the summary line for count suppressed occurrences of id
+  static size_t summary(error_value id, uint64_t count, char *buf, size_t len);
+
+  // the steady clock in ns
+  static uint64_t now();
+
+  static const size_t summary_max = 512;
+
+private:
+  error_log_limiter(const error_log_limiter &);
+  error_log_limiter &operator=(const error_log_limiter &);
+
+  // one cache line per id, so busy ids do not contend with each other
+  struct slot_type {
+    std::atomic<uint64_t> arrival;    // GCRA theoretical arrival time, ns
+    std::atomic<uint64_t> limited;    // refused, including those sampled through
+    std::atomic<uint64_t> suppressed; // refused and not logged, since the last flush
+    char padding[64 - 3 * sizeof(std::atomic<uint64_t>)];
+  };
+
+  slot_type &slot(unsigned index) const { return slots_[index - 1]; }
+
+  uint64_t interval_;   // ns per line, 0 when the burst is never replenished
+  uint64_t tolerance_;
+  unsigned burst_;
+  unsigned sample_every_;
+  unsigned capacity_;
+  void *storage_;
+  slot_type *slots_;
+};
+
+#endif /* ERROR_LOG_LIMIT_HPP_ */
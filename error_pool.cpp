@@ -0,0 +1,199 @@
+/*
+ * error_pool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_pool.hpp"
+
+namespace {
+
+// the pool this thread is working for and its deque there
+struct current_type {
+  const error_pool *pool;
+  void *own;
+};
+
+thread_local current_type current = { NULL, NULL };
+
+// steal attempts, yielding in between, before an idle thread sleeps
+const unsigned idle_rounds = 64;
+
+unsigned next_random(unsigned &seed) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+}
+
+error_pool::deque::deque() : top(0), bottom(0) {}
+
+bool error_pool::deque::push(task *t) {
+  int64_t b = bottom.load(std::memory_order_relaxed);
+  if (b - top.load(std::memory_order_acquire) >= capacity) {
+    return false;
+  }
+  slots[b & (capacity - 1)].store(t, std::memory_order_relaxed);
+  bottom.store(b + 1, std::memory_order_release);
+  return true;
+}
+
+error_pool::task *error_pool::deque::pop() {
+  int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top.load(std::memory_order_relaxed);
+  if (t > b) {
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return NULL;
+  }
+  task *x = slots[b & (capacity - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    // the last one: race the thieves for it
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      x = NULL;
+    }
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return x;
+}
+
+error_pool::task *error_pool::deque::steal() {
+  int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return NULL;
+  }
+  task *x = slots[t & (capacity - 1)].load(std::memory_order_relaxed);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return NULL;
+  }
+  return x;
+}
+
+error_pool::scope::scope(error_pool &pool)
+    : pool_(pool), own_(NULL), outside_(current.pool != &pool), saved_pool_(current.pool), saved_own_(current.own) {
+  if (outside_) {
+    pool_.outside_.lock();
+    current.pool = &pool_;
+    current.own = pool_.deques_[0];
+  }
+  own_ = static_cast<deque *>(current.own);
+}
+
+error_pool::scope::~scope() {
+  if (outside_) {
+    current.pool = saved_pool_;
+    current.own = saved_own_;
+    pool_.outside_.unlock();
+  }
+}
+
+error_pool::error_pool(unsigned threads) : sleeping_(0), stop_(false) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  for (unsigned i = 0; i < threads; ++i) {
+    deques_.push_back(new deque);
+  }
+  for (unsigned i = 1; i < threads; ++i) {
+    workers_.push_back(std::thread([this, i]() { work(i); }));
+  }
+}
+
+error_pool::~error_pool() {
+  {
+    std::lock_guard<std::mutex> hold(sleep_);
+    stop_.store(true);
+    wake_.notify_all();
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i].join();
+  }
+  for (size_t i = 0; i < deques_.size(); ++i) {
+    delete deques_[i];
+  }
+}
+
+bool error_pool::push(deque &own, task *t) {
+  if (!own.push(t)) {
+    return false;
+  }
+  // pairs with the fence in work(): either a sleeper is seen here or the
+  // task is seen there
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> hold(sleep_);
+    wake_.notify_one();
+  }
+  return true;
+}
+
+void error_pool::help(deque &own) {
+  static thread_local unsigned seed = 0x9E3779B9u;
+  task *t = own.pop();
+  if (!t) {
+    t = steal(seed, &own);
+  }
+  if (t) {
+    t->run(t);
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+error_pool::task *error_pool::steal(unsigned &seed, const deque *own) {
+  size_t n = deques_.size();
+  size_t start = next_random(seed) % n;
+  for (size_t k = 0; k < n; ++k) {
+    deque *victim = deques_[(start + k) % n];
+    if (victim != own) {
+      task *t = victim->steal();
+      if (t) {
+        return t;
+      }
+    }
+  }
+  return NULL;
+}
+
+void error_pool::work(unsigned index) {
+  deque &own = *deques_[index];
+  current.pool = this;
+  current.own = &own;
+  unsigned seed = 0x9E3779B9u * (index + 1);
+  while (!stop_.load(std::memory_order_relaxed)) {
+    task *t = NULL;
+    for (unsigned round = 0; !t && round < idle_rounds; ++round) {
+      t = steal(seed, &own);
+      if (!t) {
+        std::this_thread::yield();
+      }
+    }
+    if (t) {
+      t->run(t);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> hold(sleep_);
+    sleeping_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool idle = true;
+    for (size_t i = 0; i < deques_.size(); ++i) {
+      if (deques_[i]->top.load(std::memory_order_relaxed) < deques_[i]->bottom.load(std::memory_order_relaxed)) {
+        idle = false;
+      }
+    }
+    if (idle && !stop_.load(std::memory_order_relaxed)) {
+      wake_.wait(hold);
+    }
+    sleeping_.fetch_sub(1);
+  }
+}
@@ -0,0 +1,187 @@
+/*
+ * error_pool.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_POOL_HPP_
+#define ERROR_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "error_id.hpp"
+#include "error_latch.hpp"
+#include "error_result.hpp"
+
+// a work-stealing fork/join pool whose tasks return error_value (or an
+// error_result<T>) instead of throwing, so a failure crosses threads as a
+// pointer: no exception_ptr, no rethrow and no allocation
+//
+// each thread has a bounded Chase-Lev deque of tasks: it pushes and pops
+// its own end without a lock, idle threads steal the other end with a
+// CAS; a task is a record in the forking frame, so forking allocates
+// nothing either, and a full deque just runs the task there and then
+// which of several failures is reported is decided by an error_latch,
+// first one wins
+//
+//   error_pool pool;
+//   error_value err = pool.for_each(parts.size(), [&](size_t i) { return load(parts[i]); });
+//
+// one thread outside the pool may use it at a time (others wait their
+// turn); tasks may fork again, to any depth, and must not throw
+
+class error_pool {
+public:
+  // threads counts the caller, 0 for one per core
+  explicit error_pool(unsigned threads = 0);
+  ~error_pool();
+
+  unsigned threads() const { return static_cast<unsigned>(deques_.size()); }
+
+  // runs f1() and f2(), in parallel if a thread is free, and returns the
+  // error of whichever failed first, NULL if neither did
+  template <typename F1, typename F2> error_value invoke(F1 f1, F2 f2) {
+    error_latch latch;
+    auto first = [&f1, &latch]() { latch.set(error_of(f1())); };
+    auto second = [&f2, &latch]() { latch.set(error_of(f2())); };
+    fork(first, second);
+    return latch.get();
+  }
+
+  // f(i) for i in [0, n), split in halves down to runs of grain; once one
+  // fails no further f(i) is started and the first failure is returned
+  template <typename F> error_value for_each(size_t n, F f, size_t grain = 1) {
+    error_latch latch;
+    split(0, n, grain == 0 ? 1 : grain, [&f, &latch](size_t i) {
+      if (!latch.should_cancel()) {
+        latch.set(error_of(f(i)));
+      }
+    });
+    return latch.get();
+  }
+
+  // out[i] = f(i) for i in [0, n), f returning error_result<T>; every f(i)
+  // runs, and the first failure is returned
+  template <typename T, typename F> error_value map(size_t n, F f, error_result<T> *out, size_t grain = 1) {
+    error_latch latch;
+    split(0, n, grain == 0 ? 1 : grain, [&f, &latch, out](size_t i) {
+      out[i] = f(i);
+      latch.set(out[i].error());
+    });
+    return latch.get();
+  }
+
+private:
+  error_pool(const error_pool &);
+  error_pool &operator=(const error_pool &);
+
+  struct task {
+    void (*run)(task *);
+    std::atomic<bool> done;
+  };
+
+  template <typename F> struct closure : task {
+    explicit closure(F &f) : f_(f) {
+      run = &call;
+      done.store(false, std::memory_order_relaxed);
+    }
+    static void call(task *t) {
+      static_cast<closure *>(t)->f_();
+      t->done.store(true, std::memory_order_release);
+    }
+    F &f_;
+  };
+
+  // bounded Chase-Lev deque: the owner pushes and pops at the bottom,
+  // thieves take from the top
+  struct deque {
+    static const int64_t capacity = 1024;
+
+    deque();
+    bool push(task *t);
+    task *pop();
+    task *steal();
+
+    std::atomic<int64_t> top;
+    char top_padding[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> bottom;
+    std::atomic<task *> slots[capacity];
+  };
+
+  // this thread's deque while it works for the pool
+  class scope {
+  public:
+    explicit scope(error_pool &pool);
+    ~scope();
+    deque &own() const { return *own_; }
+
+  private:
+    error_pool &pool_;
+    deque *own_;
+    bool outside_;
+    const error_pool *saved_pool_;  // a pool this thread works for already
+    void *saved_own_;
+  };
+
+  static error_value error_of(error_value err) { return err; }
+  template <typename T> static error_value error_of(const error_result<T> &result) { return result.error(); }
+
+  // runs f1 here while f2 waits to be stolen, then waits for f2
+  template <typename F1, typename F2> void fork(F1 &f1, F2 &f2) {
+    scope here(*this);
+    closure<F2> second(f2);
+    if (!push(here.own(), &second)) {
+      f2();
+      f1();
+      return;
+    }
+    f1();
+    task *t = here.own().pop();
+    if (t == &second) {
+      f2();
+      return;
+    }
+    // stolen: help with other work until it is done
+    while (!second.done.load(std::memory_order_acquire)) {
+      help(here.own());
+    }
+  }
+
+  template <typename F> void split(size_t begin, size_t end, size_t grain, const F &leaf) {
+    if (end - begin <= grain) {
+      for (size_t i = begin; i < end; ++i) {
+        leaf(i);
+      }
+      return;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    auto low = [&]() { split(begin, middle, grain, leaf); };
+    auto high = [&]() { split(middle, end, grain, leaf); };
+    fork(low, high);
+  }
+
+  bool push(deque &own, task *t);
+
+  // runs one task taken from own or stolen from another thread, or yields
+  void help(deque &own);
+  task *steal(unsigned &seed, const deque *own);
+
+  void work(unsigned index);
+
+  std::vector<deque *> deques_;  // [0] for the thread outside the pool
+  std::vector<std::thread> workers_;
+  std::mutex outside_;           // held by the outside thread using the pool
+  std::mutex sleep_;
+  std::condition_variable wake_;
+  std::atomic<unsigned> sleeping_;
+  std::atomic<bool> stop_;
+};
+
+#endif /* ERROR_POOL_HPP_ */
@@ -0,0 +1,98 @@
+/*
+ * error_probe.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_PROBE_HPP_
+#define ERROR_PROBE_HPP_
+
+// static (USDT/SDT) tracepoints on error raises, for perf and bpftrace:
+//   bpftrace -e 'usdt:./Default/errorcodeNX:errorid:raise { printf("%s\n", str(arg0)); }'
+// build with -DERROR_ID_USDT=1 (make USDT=1) to emit them; each probe is
+// then a single nop plus an ELF note, and nothing at all otherwise
+//
+// arg0 is the error_value, arg1 the address of the raise site: a label
+// taken where the probe expands, so once the inline helpers holding the
+// probes (raise_id, raise_typed, the typed_error constructor) are inlined,
+// as in optimised builds, it lies in the raising function itself; tools
+// that do not report the probe's own address can symbolise arg1 instead.
+// Unoptimised builds call the helpers, and both are then in the helper
+
+#ifndef ERROR_ID_USDT
+#define ERROR_ID_USDT 0
+#endif
+
+#if ERROR_ID_USDT
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define ERROR_ID_HAVE_SYS_SDT 1
+#endif
+#endif
+
+// the address of this point in the code
+#if defined(__x86_64__)
+#define ERROR_ID_PROBE_SITE(site) __asm__ __volatile__("lea 1f(%%rip), %0\n1:" : "=r"(site))
+#elif defined(__aarch64__)
+#define ERROR_ID_PROBE_SITE(site) __asm__ __volatile__("adr %0, 1f\n1:" : "=r"(site))
+#else
+#define ERROR_ID_PROBE_SITE(site) ((site) = 0)
+#endif
+
+#if defined(ERROR_ID_HAVE_SYS_SDT)
+
+#include <sys/sdt.h>
+
+#define ERROR_ID_PROBE(name, err)                                                \
+  do {                                                                           \
+    const void *error_id_site_;                                                  \
+    ERROR_ID_PROBE_SITE(error_id_site_);                                         \
+    DTRACE_PROBE2(errorid, name, (err), error_id_site_);                         \
+  } while (0)
+
+#elif defined(__GNUC__) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__))
+
+// without systemtap's header emit the same version 3 stapsdt note directly
+#define ERROR_ID_PROBE(name, err)                                                \
+  do {                                                                           \
+    const void *error_id_site_;                                                  \
+    ERROR_ID_PROBE_SITE(error_id_site_);                                         \
+    __asm__ __volatile__("990: nop\n"                                            \
+                         ".pushsection .note.stapsdt,\"?\",\"note\"\n"           \
+                         ".balign 4\n"                                           \
+                         ".4byte 992f-991f, 994f-993f, 3\n"                      \
+                         "991: .asciz \"stapsdt\"\n"                             \
+                         "992: .balign 4\n"                                      \
+                         "993: .8byte 990b\n"                                    \
+                         ".8byte _.stapsdt.base\n"                               \
+                         ".8byte 0\n"                                            \
+                         ".asciz \"errorid\"\n"                                  \
+                         ".asciz \"" #name "\"\n"                                \
+                         ".asciz \"8@%[error] 8@%[site]\"\n"                     \
+                         "994: .balign 4\n"                                      \
+                         ".popsection\n"                                         \
+                         ".ifndef _.stapsdt.base\n"                              \
+                         ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+                         ".weak _.stapsdt.base\n"                                \
+                         ".hidden _.stapsdt.base\n"                              \
+                         "_.stapsdt.base: .space 1\n"                            \
+                         ".size _.stapsdt.base, 1\n"                             \
+                         ".popsection\n"                                         \
+                         ".endif\n"                                              \
+                         :                                                       \
+                         : [error] "r"(static_cast<const void *>(err)), [site] "r"(error_id_site_)); \
+  } while (0)
+
+#else
+#error "ERROR_ID_USDT needs <sys/sdt.h> or an ELF x86-64/AArch64 GNU toolchain"
+#endif
+
+#else
+
+#define ERROR_ID_PROBE(name, err) ((void)0)
+
+#endif
+
+#endif /* ERROR_PROBE_HPP_ */
@@ -0,0 +1,98 @@
+/*
+ * error_rate.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_rate.hpp"
+
+#include <chrono>
+#include <new>
+
+#include "error_registry.hpp"
+
+namespace {
+
+const unsigned cache_line = 64;
+
+inline uint64_t pack(uint32_t second, uint32_t count) { return (static_cast<uint64_t>(second) << 32) | count; }
+
+inline uint32_t second_of(uint64_t bucket) { return static_cast<uint32_t>(bucket >> 32); }
+
+inline uint32_t count_of(uint64_t bucket) { return static_cast<uint32_t>(bucket); }
+
+}
+
+error_rate_tracker::error_rate_tracker(unsigned capacity)
+    : capacity_(capacity), storage_(NULL), rings_(NULL) {
+  // each ring is a whole number of cache lines, and the first starts on one
+  const size_t bytes = static_cast<size_t>(capacity_) * buckets * sizeof(std::atomic<uint64_t>);
+  storage_ = ::operator new(bytes + cache_line);
+  uintptr_t aligned = (reinterpret_cast<uintptr_t>(storage_) + cache_line - 1) & ~static_cast<uintptr_t>(cache_line - 1);
+  rings_ = reinterpret_cast<std::atomic<uint64_t> *>(aligned);
+  for (size_t i = 0; i < static_cast<size_t>(capacity_) * buckets; ++i) {
+    new (&rings_[i]) std::atomic<uint64_t>(0);
+  }
+}
+
+error_rate_tracker::~error_rate_tracker() { ::operator delete(storage_); }
+
+void error_rate_tracker::record(error_value id, uint32_t second) {
+  unsigned index = error_registry::add(id);
+  if (index == 0 || index > capacity_) {
+    return;
+  }
+  std::atomic<uint64_t> &bucket = ring(index)[second % buckets];
+  uint64_t current = bucket.load(std::memory_order_relaxed);
+  for (;;) {
+    uint32_t bucket_second = second_of(current);
+    if (bucket_second == second) {
+      bucket.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (bucket_second > second) {
+      // a writer running a full ring behind: too late to count
+      return;
+    }
+    // first occurrence in this second, recycle the bucket
+    if (bucket.compare_exchange_weak(current, pack(second, 1), std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+uint64_t error_rate_tracker::count(error_value id, unsigned window, uint32_t second) const {
+  unsigned index = error_registry::index_of(id);
+  if (index == 0 || index > capacity_) {
+    return 0;
+  }
+  if (window > max_window) {
+    window = max_window;
+  }
+  const std::atomic<uint64_t> *buckets_for_id = ring(index);
+  uint64_t total = 0;
+  for (unsigned age = 0; age < window && age <= second; ++age) {
+    uint32_t wanted = second - age;
+    uint64_t bucket = buckets_for_id[wanted % buckets].load(std::memory_order_relaxed);
+    if (second_of(bucket) == wanted) {
+      total += count_of(bucket);
+    }
+  }
+  return total;
+}
+
+double error_rate_tracker::rate(error_value id, unsigned window, uint32_t second) const {
+  if (window == 0) {
+    return 0;
+  }
+  if (window > max_window) {
+    window = max_window;
+  }
+  return static_cast<double>(count(id, window, second)) / window;
+}
+
+uint32_t error_rate_tracker::now() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
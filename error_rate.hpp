@@ -0,0 +1,61 @@
+/*
+ * error_rate.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_RATE_HPP_
+#define ERROR_RATE_HPP_
+
+#include <atomic>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// sliding window occurrence counts per error_id, e.g. "eBAR per second over
+// the last 10s" for health checks
+// each id owns a ring of one second buckets indexed by its registry index;
+// a bucket packs the second it belongs to with its count in one word, so a
+// writer touches a single cache line with one atomic add (or, on the first
+// hit in a new second, one CAS) and never takes a lock
+
+class error_rate_tracker {
+public:
+  // one bucket per second: windows of up to buckets - 1 seconds are exact
+  static const unsigned buckets = 64;
+  static const unsigned max_window = buckets - 1;
+
+  // tracks ids whose registry index is at most capacity, others are ignored
+  explicit error_rate_tracker(unsigned capacity = 1024);
+  ~error_rate_tracker();
+
+  // records one occurrence now, registering id on first sight
+  void record(error_value id) { record(id, now()); }
+  void record(error_value id, uint32_t second);
+
+  // occurrences in the window seconds ending with (and including) second
+  uint64_t count(error_value id, unsigned window) const { return count(id, window, now()); }
+  uint64_t count(error_value id, unsigned window, uint32_t second) const;
+
+  // occurrences per second averaged over the window
+  double rate(error_value id, unsigned window) const { return rate(id, window, now()); }
+  double rate(error_value id, unsigned window, uint32_t second) const;
+
+  unsigned capacity() const { return capacity_; }
+
+  // the current second on the steady clock
+  static uint32_t now();
+
+private:
+  error_rate_tracker(const error_rate_tracker &);
+  error_rate_tracker &operator=(const error_rate_tracker &);
+
+  std::atomic<uint64_t> *ring(unsigned index) const { return rings_ + static_cast<uint64_t>(index - 1) * buckets; }
+
+  unsigned capacity_;
+  void *storage_;
+  std::atomic<uint64_t> *rings_;
+};
+
+#endif /* ERROR_RATE_HPP_ */
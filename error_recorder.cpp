@@ -0,0 +1,118 @@
+/*
+ * error_recorder.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_recorder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// the context travels as whole words, so that a reader racing a writer
+// reads atomics rather than torn bytes
+const size_t context_words = error_record::context_size / sizeof(uint64_t);
+
+// sequence is 2 * ticket + 1 while the entry of ticket is written, and
+// 2 * ticket + 2 once it is complete
+struct slot {
+  std::atomic<uint64_t> sequence;
+  std::atomic<error_value> error;
+  std::atomic<uint64_t> time;
+  std::atomic<uint32_t> thread;
+  std::atomic<uint64_t> context[context_words];
+};
+
+// constant initialised, so recording from static initialisers is safe
+slot slots[error_recorder::capacity];
+std::atomic<uint64_t> head(0);
+std::atomic<uint64_t> drops(0);
+std::atomic<uint32_t> threads(0);
+
+thread_local uint32_t this_thread = 0;
+
+inline uint64_t complete(uint64_t ticket) { return 2 * ticket + 2; }
+
+}
+
+void error_recorder::record(error_value err, const char *context) {
+  uint64_t ticket = head.fetch_add(1, std::memory_order_relaxed);
+  slot &s = slots[ticket % capacity];
+
+  // the slot is ours unless an earlier entry is still being written there,
+  // or a later one has taken it already
+  uint64_t sequence = s.sequence.load(std::memory_order_relaxed);
+  do {
+    if ((sequence & 1) || sequence > 2 * ticket) {
+      drops.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  } while (!s.sequence.compare_exchange_weak(sequence, 2 * ticket + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed));
+  // a reader that sees any of the stores below sees the slot taken
+  std::atomic_thread_fence(std::memory_order_release);
+
+  uint64_t words[context_words] = {};
+  if (context) {
+    size_t length = std::strlen(context);
+    if (length >= error_record::context_size) {
+      length = error_record::context_size - 1;
+    }
+    std::memcpy(words, context, length);
+  }
+  s.error.store(err, std::memory_order_relaxed);
+  s.time.store(now(), std::memory_order_relaxed);
+  s.thread.store(thread(), std::memory_order_relaxed);
+  for (size_t w = 0; w < context_words; ++w) {
+    s.context[w].store(words[w], std::memory_order_relaxed);
+  }
+  s.sequence.store(complete(ticket), std::memory_order_release);
+}
+
+size_t error_recorder::snapshot(error_record *out, size_t max) {
+  uint64_t end = head.load(std::memory_order_acquire);
+  uint64_t wanted = max < capacity ? max : capacity;
+  uint64_t ticket = end > wanted ? end - wanted : 0;
+  size_t copied = 0;
+  for (; ticket < end; ++ticket) {
+    slot &s = slots[ticket % capacity];
+    if (s.sequence.load(std::memory_order_acquire) != complete(ticket)) {
+      continue;  // still being written, dropped, or already overwritten
+    }
+    error_record &r = out[copied];
+    r.error = s.error.load(std::memory_order_relaxed);
+    r.time = s.time.load(std::memory_order_relaxed);
+    r.thread = s.thread.load(std::memory_order_relaxed);
+    uint64_t words[context_words];
+    for (size_t w = 0; w < context_words; ++w) {
+      words[w] = s.context[w].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.sequence.load(std::memory_order_relaxed) != complete(ticket)) {
+      continue;  // overwritten while copying
+    }
+    std::memcpy(r.context, words, error_record::context_size);
+    ++copied;
+  }
+  return copied;
+}
+
+uint64_t error_recorder::recorded() { return head.load(std::memory_order_relaxed); }
+
+uint64_t error_recorder::dropped() { return drops.load(std::memory_order_relaxed); }
+
+uint64_t error_recorder::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t error_recorder::thread() {
+  if (!this_thread) {
+    this_thread = threads.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+  return this_thread;
+}
@@ -0,0 +1,58 @@
+/*
+ * error_recorder.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_RECORDER_HPP_
+#define ERROR_RECORDER_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// a flight recorder: the last capacity errors raised anywhere in the
+// process, with when, on which thread and a short context, to be dumped
+// after the fact (a crash handler, a health endpoint, a debugger)
+//
+// record() takes a ticket with one atomic add and writes its slot under a
+// per-slot sequence number, so writers never wait on each other or on
+// readers; a writer that finds its slot still being written a full ring
+// earlier drops its entry rather than wait. snapshot() copies entries out
+// and skips any that were rewritten while it read them
+
+struct error_record {
+  static const size_t context_size = 40;
+
+  error_value error;
+  uint64_t time;                // error_recorder::now() when recorded
+  uint32_t thread;              // small per-thread number, from 1
+  char context[context_size];   // NUL terminated, cut short if need be
+};
+
+class error_recorder {
+public:
+  static const unsigned capacity = 4096;
+
+  static void record(error_value err, const char *context = NULL);
+
+  // copies up to max of the most recent entries to out, oldest first, and
+  // returns how many were copied
+  static size_t snapshot(error_record *out, size_t max);
+
+  // entries recorded since startup, dropped ones included
+  static uint64_t recorded();
+
+  // entries dropped because their slot was busy
+  static uint64_t dropped();
+
+  // nanoseconds on the steady clock
+  static uint64_t now();
+
+  // this thread's number in error_record::thread
+  static uint32_t thread();
+};
+
+#endif /* ERROR_RECORDER_HPP_ */
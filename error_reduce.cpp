@@ -0,0 +1,147 @@
+/*
+ * error_reduce.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_reduce.hpp"
+
+#include "error_registry.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ERROR_REDUCE_AVX2 1
+#include <immintrin.h>
+#else
+#define ERROR_REDUCE_AVX2 0
+#endif
+
+namespace {
+
+// values per AVX2 step: four vectors of four pointers
+const size_t step = 16;
+
+size_t first_scalar(const error_value *values, size_t from, size_t n) {
+  for (size_t i = from; i < n; ++i) {
+    if (values[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+size_t count_scalar(const error_value *values, size_t from, size_t n) {
+  size_t failed = 0;
+  for (size_t i = from; i < n; ++i) {
+    failed += values[i] != NULL;
+  }
+  return failed;
+}
+
+#if ERROR_REDUCE_AVX2
+
+__attribute__((target("avx2"))) inline __m256i load(const error_value *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+
+// whether any of the step's values is non NULL
+__attribute__((target("avx2"))) inline bool any_failed(const error_value *p) {
+  __m256i all = _mm256_or_si256(_mm256_or_si256(load(p), load(p + step / 4)),
+                                _mm256_or_si256(load(p + step / 2), load(p + 3 * step / 4)));
+  return !_mm256_testz_si256(all, all);
+}
+
+__attribute__((target("avx2"))) size_t first_avx2(const error_value *values, size_t n) {
+  size_t i = 0;
+  while (i + step <= n && !any_failed(values + i)) {
+    i += step;
+  }
+  return first_scalar(values, i, n);
+}
+
+__attribute__((target("avx2"))) size_t count_avx2(const error_value *values, size_t n) {
+  // each lane counts its NULLs down from zero (cmpeq gives -1)
+  __m256i nulls = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t v = 0; v < step; v += step / 4) {
+      nulls = _mm256_add_epi64(nulls, _mm256_cmpeq_epi64(load(values + i + v), _mm256_setzero_si256()));
+    }
+  }
+  long long lanes[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), nulls);
+  size_t succeeded = -(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+  return i - succeeded + count_scalar(values, i, n);
+}
+
+__attribute__((target("avx2"))) size_t next_candidate(const error_value *values, size_t i, size_t n) {
+  while (i + step <= n && !any_failed(values + i)) {
+    i += step;
+  }
+  return i;
+}
+
+bool has_avx2() {
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+}
+
+#else
+
+size_t next_candidate(const error_value *, size_t i, size_t) { return i; }
+
+bool has_avx2() { return false; }
+
+#endif
+
+}
+
+size_t error_reduce::first(const error_value *values, size_t n) {
+#if ERROR_REDUCE_AVX2
+  if (has_avx2()) {
+    return first_avx2(values, n);
+  }
+#endif
+  return first_scalar(values, 0, n);
+}
+
+size_t error_reduce::count(const error_value *values, size_t n) {
+#if ERROR_REDUCE_AVX2
+  if (has_avx2()) {
+    return count_avx2(values, n);
+  }
+#endif
+  return count_scalar(values, 0, n);
+}
+
+void error_reduce::histogram(const error_value *values, size_t n, std::vector<size_t> &counts) {
+  bool avx2 = has_avx2();
+  // failures tend to come in runs of the same id, so remember the last one
+  error_value last = NULL;
+  unsigned last_index = 0;
+  if (counts.empty()) {
+    counts.resize(1, 0);
+  }
+  size_t i = 0;
+  while (i < n) {
+    if (avx2) {
+      i = next_candidate(values, i, n);
+    }
+    // scan the rest of this step (or everything, without AVX2) one by one
+    size_t end = avx2 && i + step <= n ? i + step : n;
+    for (; i < end; ++i) {
+      error_value err = values[i];
+      if (!err) {
+        continue;
+      }
+      if (err != last) {
+        last = err;
+        last_index = error_registry::add(err);
+        if (last_index >= counts.size()) {
+          counts.resize(last_index + 1, 0);
+        }
+      }
+      ++counts[last_index];
+    }
+  }
+}
+
+bool error_reduce::vectorised() { return has_avx2(); }
@@ -0,0 +1,48 @@
+/*
+ * error_reduce.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_REDUCE_HPP_
+#define ERROR_REDUCE_HPP_
+
+#include <stddef.h>
+#include <vector>
+
+#include "error_id.hpp"
+
+// reductions over the error_value results of a batch, e.g. one per step or
+// per task - in place of the hand written loop
+//
+//   for (i = 0; i < n; ++i) if (results[i]) return results[i];
+//
+// failures are expected to be rare, so the kernels test 16 results per
+// step with AVX2 when the CPU has it (a scalar loop otherwise) and only
+// look closer at steps holding a failure
+
+class error_reduce {
+public:
+  // the position of the first non NULL value, n if there is none
+  static size_t first(const error_value *values, size_t n);
+
+  // the first non NULL value, NULL if every step succeeded
+  static error_value first_error(const error_value *values, size_t n) {
+    size_t i = first(values, n);
+    return i < n ? values[i] : NULL;
+  }
+
+  // the number of non NULL values
+  static size_t count(const error_value *values, size_t n);
+
+  // adds one to counts[error_registry index] for each non NULL value,
+  // registering ids on first sight and growing counts as needed
+  // ids the registry has no room for are counted in counts[0]
+  static void histogram(const error_value *values, size_t n, std::vector<size_t> &counts);
+
+  // whether the AVX2 kernels are in use
+  static bool vectorised();
+};
+
+#endif /* ERROR_REDUCE_HPP_ */
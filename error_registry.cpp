@@ -0,0 +1,95 @@
+/*
+ * error_registry.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_registry.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+namespace {
+
+// open addressing on the pointer value, never more than half full
+const unsigned table_bits = 17;
+const unsigned table_size = 1u << table_bits;
+
+// all of these are constant initialised, so registrations made from other
+// translation units' static initialisers are safe
+std::atomic<error_value> keys[table_size];
+std::atomic<unsigned> values[table_size];
+std::atomic<error_value> ids[error_registry::max_ids + 1];
+std::atomic<unsigned> count(0);
+std::mutex registration;
+
+inline unsigned slot_for(error_value id) {
+  // fibonacci hashing of the address, the low bits are mostly alignment
+  uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(id)) * 0x9E3779B97F4A7C15ull;
+  return static_cast<unsigned>(h >> (64 - table_bits));
+}
+
+}
+
+unsigned error_registry::add(error_value id) {
+  if (!id) {
+    return 0;
+  }
+  unsigned index = index_of(id);
+  if (index) {
+    return index;
+  }
+
+  std::lock_guard<std::mutex> lock(registration);
+  unsigned slot = slot_for(id);
+  for (;;) {
+    error_value key = keys[slot].load(std::memory_order_relaxed);
+    if (key == id) {
+      // registered by another thread since the lock-free check
+      return values[slot].load(std::memory_order_relaxed);
+    }
+    if (!key) {
+      break;
+    }
+    slot = (slot + 1) & (table_size - 1);
+  }
+
+  index = count.load(std::memory_order_relaxed) + 1;
+  if (index > max_ids) {
+    return 0;
+  }
+  ids[index].store(id, std::memory_order_relaxed);
+  values[slot].store(index, std::memory_order_relaxed);
+  // publishing the key releases the value and the dense entry with it
+  keys[slot].store(id, std::memory_order_release);
+  count.store(index, std::memory_order_release);
+  return index;
+}
+
+unsigned error_registry::index_of(error_value id) {
+  if (!id) {
+    return 0;
+  }
+  unsigned slot = slot_for(id);
+  for (;;) {
+    error_value key = keys[slot].load(std::memory_order_acquire);
+    if (key == id) {
+      return values[slot].load(std::memory_order_relaxed);
+    }
+    if (!key) {
+      return 0;
+    }
+    slot = (slot + 1) & (table_size - 1);
+  }
+}
+
+error_value error_registry::at(unsigned index) {
+  if (index == 0 || index > count.load(std::memory_order_acquire)) {
+    return NULL;
+  }
+  return ids[index].load(std::memory_order_relaxed);
+}
+
+unsigned error_registry::size() { return count.load(std::memory_order_acquire); }
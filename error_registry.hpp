@@ -0,0 +1,52 @@
+/*
+ * error_registry.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_REGISTRY_HPP_
+#define ERROR_REGISTRY_HPP_
+
+#include "error_id.hpp"
+
+// the registry gives each error_id it is told about a small dense index,
+// counting up from 1, so that per-error state can be kept in plain arrays
+// the identity remains the pointer: two ids with the same text are distinct
+// entries, exactly as they are distinct errors
+//
+// registration takes a lock and is expected at startup (or on first sight
+// of an id); lookup in either direction is lock-free
+
+class error_registry {
+public:
+  // dense indices fit in 16 bits, 0 is reserved for "not registered"
+  static const unsigned max_ids = 65535;
+
+  // registers id if it is not already known, returning its index
+  // returns 0 for NULL, or when the registry is full
+  static unsigned add(error_value id);
+
+  // the index of id, 0 if it has not been registered
+  static unsigned index_of(error_value id);
+
+  // the id with the given index, NULL if there is none
+  static error_value at(unsigned index);
+
+  // the number of registered ids, indices run from 1 to size()
+  static unsigned size();
+};
+
+// registers an error_id during static initialisation
+//   static error_registration reg_eFOO(FooErrors::eFOO);
+class error_registration {
+public:
+  explicit error_registration(error_value id) : index_(error_registry::add(id)) {}
+
+  unsigned index() const { return index_; }
+
+private:
+  unsigned index_;
+};
+
+#endif /* ERROR_REGISTRY_HPP_ */
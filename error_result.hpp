@@ -0,0 +1,120 @@
+/*
+ * error_result.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_RESULT_HPP_
+#define ERROR_RESULT_HPP_
+
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "error_id.hpp"
+
+// a T or the error_value saying why there is none, for code that returns
+// its failures rather than throwing them
+// failing costs a pointer store: the T is never constructed and nothing is
+// allocated, and since error_values compare by identity callers test
+// error() == GRP_FOO::eBAR without knowing anything else about it
+//
+//   error_result<size_t> parse(const char *text) {
+//     if (!*text) {
+//       return error_fail(GRP_FOO::eEMPTY);
+//     }
+//     return std::strlen(text);
+//   }
+//
+// failures are spelt out with error_fail(), so that a T that an error_value
+// converts to (const char *, std::string) is never taken for an error
+//
+// if assigning a T throws, the result assigned to is left failed with
+// error_result_lost(), never holding a destroyed T
+
+// an error_value on its way into an error_result, see error_fail()
+struct error_failure {
+  error_value error;
+};
+
+// err must not be NULL
+inline error_failure error_fail(error_value err) {
+  assert(err != NULL);
+  error_failure failure = { err };
+  return failure;
+}
+
+// the error of a result whose value was lost to a throwing assignment
+inline error_value error_result_lost() {
+  static error_id lost = SCOPE_ERROR("ERRORID", "RESULT", "Value lost to a throwing assignment");
+  return lost;
+}
+
+template <typename T> class error_result {
+public:
+  error_result(const T &value) : error_(NULL) { new (&storage_) T(value); }
+  error_result(T &&value) : error_(NULL) { new (&storage_) T(std::move(value)); }
+
+  error_result(error_failure failure) : error_(failure.error) { assert(error_ != NULL); }
+
+  error_result(const error_result &other) : error_(other.error_) {
+    if (!error_) {
+      new (&storage_) T(other.value());
+    }
+  }
+
+  error_result(error_result &&other) noexcept(std::is_nothrow_move_constructible<T>::value) : error_(other.error_) {
+    if (!error_) {
+      new (&storage_) T(std::move(other.value()));
+    }
+  }
+
+  ~error_result() { destroy(); }
+
+  error_result &operator=(const error_result &other) {
+    if (this != &other) {
+      destroy();
+      error_ = other.error_ ? other.error_ : error_result_lost();
+      if (!other.error_) {
+        new (&storage_) T(other.value());
+        error_ = NULL;
+      }
+    }
+    return *this;
+  }
+
+  error_result &operator=(error_result &&other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      destroy();
+      error_ = other.error_ ? other.error_ : error_result_lost();
+      if (!other.error_) {
+        new (&storage_) T(std::move(other.value()));
+        error_ = NULL;
+      }
+    }
+    return *this;
+  }
+
+  bool ok() const { return error_ == NULL; }
+
+  // NULL on success
+  error_value error() const { return error_; }
+
+  // only when ok()
+  T &value() { return *reinterpret_cast<T *>(&storage_); }
+  const T &value() const { return *reinterpret_cast<const T *>(&storage_); }
+
+private:
+  void destroy() {
+    if (!error_) {
+      value().~T();
+    }
+  }
+
+  error_value error_;
+  typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage_;
+};
+
+#endif /* ERROR_RESULT_HPP_ */
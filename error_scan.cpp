@@ -0,0 +1,286 @@
+/*
+ * error_scan.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_scan.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "error_registry.hpp"
+
+namespace {
+
+const uint32_t none = 0xFFFFFFFFu;
+
+std::vector<error_value> registered_ids() {
+  std::vector<error_value> ids;
+  unsigned size = error_registry::size();
+  for (unsigned index = 1; index <= size; ++index) {
+    ids.push_back(error_registry::at(index));
+  }
+  return ids;
+}
+
+}
+
+const size_t error_scanner::default_table_bytes;
+const size_t error_scanner::max_dense_bytes;
+const size_t error_scanner::max_text;
+
+error_scanner::error_scanner() { build(registered_ids(), default_table_bytes); }
+
+error_scanner::error_scanner(const std::vector<error_value> &ids, size_t max_table_bytes) {
+  build(ids, max_table_bytes);
+}
+
+const char *error_scanner::skip(const char *p, const char *end) const {
+#if defined(__SSE2__)
+  if (start_count_) {
+    __m128i starts[4];
+    for (unsigned i = 0; i < 4; ++i) {
+      // unused entries repeat the first, which changes nothing
+      starts[i] = _mm_set1_epi8(static_cast<char>(starts_[i < start_count_ ? i : 0]));
+    }
+    for (; end - p >= 16; p += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, starts[0]), _mm_cmpeq_epi8(v, starts[1])),
+                                 _mm_or_si128(_mm_cmpeq_epi8(v, starts[2]), _mm_cmpeq_epi8(v, starts[3])));
+      unsigned mask = _mm_movemask_epi8(hit);
+      if (mask) {
+        return p + __builtin_ctz(mask);
+      }
+    }
+    for (; p != end; ++p) {
+      if (std::memchr(starts_, *p, start_count_)) {
+        return p;
+      }
+    }
+    return end;
+  }
+#endif
+  (void)end;
+  return p;
+}
+
+uint32_t error_scanner::sparse_next(uint32_t state, unsigned char c) const {
+  while (state >= dense_limit_) {
+    uint32_t s = state - dense_limit_;
+    for (uint32_t e = sparse_begin_[s]; e != sparse_begin_[s + 1]; ++e) {
+      if (sparse_class_[e] == c) {
+        return sparse_target_[e];
+      }
+    }
+    state = sparse_fail_[s];
+  }
+  return next_[state + c];
+}
+
+size_t error_scanner::count(const char *begin, const char *end) const {
+  size_t n = 0;
+  scan(begin, end, [&n](const char *, error_value) { ++n; });
+  return n;
+}
+
+void error_scanner::build(const std::vector<error_value> &ids, size_t max_table_bytes) {
+  size_t text = 0;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (ids[i] && *ids[i]) {
+      text += std::strlen(ids[i]);
+      if (text > max_text) {
+        break;
+      }
+      ids_.push_back(ids[i]);
+    }
+  }
+
+  std::memset(classes_, 0, sizeof(classes_));
+  class_count_ = 1;
+  for (size_t i = 0; i < ids_.size(); ++i) {
+    for (const char *p = ids_[i]; *p; ++p) {
+      unsigned char &c = classes_[static_cast<unsigned char>(*p)];
+      if (!c) {
+        c = static_cast<unsigned char>(class_count_++);
+      }
+    }
+  }
+
+  start_count_ = 0;
+  for (size_t i = 0; i < ids_.size() && start_count_ <= sizeof(starts_); ++i) {
+    unsigned char c = static_cast<unsigned char>(ids_[i][0]);
+    if (!std::memchr(starts_, c, start_count_)) {
+      if (start_count_ < sizeof(starts_)) {
+        starts_[start_count_] = c;
+      }
+      ++start_count_;
+    }
+  }
+  if (start_count_ > sizeof(starts_)) {
+    // too many to test at once, scan byte by byte
+    start_count_ = 0;
+  }
+
+  // the trie, each state's edges a list through its children's siblings
+  std::vector<uint32_t> child(1, none);
+  std::vector<uint32_t> sibling(1, none);
+  std::vector<unsigned char> label(1, 0);
+  std::vector<uint32_t> match(1, none);
+  for (size_t i = 0; i < ids_.size(); ++i) {
+    uint32_t state = 0;
+    for (const char *p = ids_[i]; *p; ++p) {
+      unsigned char c = classes_[static_cast<unsigned char>(*p)];
+      uint32_t edge = child[state];
+      while (edge != none && label[edge] != c) {
+        edge = sibling[edge];
+      }
+      if (edge == none) {
+        edge = static_cast<uint32_t>(match.size());
+        child.push_back(none);
+        sibling.push_back(child[state]);
+        label.push_back(c);
+        match.push_back(none);
+        child[state] = edge;
+      }
+      state = edge;
+    }
+    if (match[state] == none) {
+      match[state] = static_cast<uint32_t>(i);
+    }
+  }
+
+  // breadth first, so each state's failure state (shallower) comes before it
+  uint32_t states = static_cast<uint32_t>(match.size());
+  std::vector<uint32_t> fail(states, 0);
+  std::vector<uint32_t> output(states, 0);
+  std::vector<uint32_t> depth(states, 0);
+  std::vector<uint32_t> bfs(1, 0);
+  for (size_t q = 0; q < bfs.size(); ++q) {
+    uint32_t state = bfs[q];
+    output[state] = match[fail[state]] != none ? fail[state] : output[fail[state]];
+    for (uint32_t edge = child[state]; edge != none; edge = sibling[edge]) {
+      if (state) {
+        uint32_t f = fail[state];
+        for (;;) {
+          uint32_t e = child[f];
+          while (e != none && label[e] != label[edge]) {
+            e = sibling[e];
+          }
+          if (e != none) {
+            fail[edge] = e;
+            break;
+          }
+          if (!f) {
+            break;
+          }
+          f = fail[f];
+        }
+      }
+      depth[edge] = depth[state] + 1;
+      bfs.push_back(edge);
+    }
+  }
+
+  // the states shallower than the deepest cut keeping the table within
+  // max_table_bytes get full rows, the rest are sparse
+  size_t max_rows = std::min(max_table_bytes, max_dense_bytes) / (class_count_ * sizeof(uint32_t));
+  uint32_t dense_depth = 1;
+  for (uint32_t q = 1; q <= states; ++q) {
+    if (q == states || depth[bfs[q]] != depth[bfs[q - 1]]) {
+      // bfs[0, q) are the states no deeper than bfs[q - 1]
+      if (q > max_rows) {
+        break;
+      }
+      dense_depth = depth[bfs[q - 1]] + 1;
+    }
+  }
+
+  // renumber, outputs last within each kind; the root, never a match, is 0
+  std::vector<uint32_t> order(states);
+  uint32_t dense_count = 0;
+  uint32_t sparse_count = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (uint32_t s = 0; s < states; ++s) {
+      bool is_output = match[s] != none || output[s];
+      if (is_output == (pass == 1)) {
+        order[s] = depth[s] < dense_depth ? dense_count++ : sparse_count++;
+      }
+    }
+    if (pass == 0) {
+      first_output_ = dense_count * class_count_;
+      sparse_first_output_ = sparse_count;
+    }
+  }
+  dense_limit_ = dense_count * class_count_;
+  sparse_first_output_ += dense_limit_;
+  dense_outputs_ = dense_count - first_output_ / class_count_;
+  std::vector<uint32_t> value(states);
+  for (uint32_t s = 0; s < states; ++s) {
+    value[s] = depth[s] < dense_depth ? order[s] * class_count_ : dense_limit_ + order[s];
+  }
+
+  // dense rows are complete, missing edges filled from the failure state's
+  // row, which being shallower is dense and already filled
+  next_.assign(dense_limit_, 0);
+  sparse_begin_.assign(sparse_count + 1, 0);
+  sparse_fail_.assign(sparse_count, 0);
+  std::vector<uint32_t> edges(sparse_count, 0);
+  for (uint32_t s = 0; s < states; ++s) {
+    if (depth[s] >= dense_depth) {
+      for (uint32_t edge = child[s]; edge != none; edge = sibling[edge]) {
+        ++edges[order[s]];
+      }
+    }
+  }
+  for (uint32_t k = 0; k < sparse_count; ++k) {
+    sparse_begin_[k + 1] = sparse_begin_[k] + edges[k];
+  }
+  sparse_class_.assign(sparse_begin_[sparse_count], 0);
+  sparse_target_.assign(sparse_begin_[sparse_count], 0);
+  for (size_t q = 0; q < states; ++q) {
+    uint32_t s = bfs[q];
+    if (depth[s] < dense_depth) {
+      uint32_t *row = &next_[value[s]];
+      if (s) {
+        std::memcpy(row, &next_[value[fail[s]]], class_count_ * sizeof(uint32_t));
+      }
+      for (uint32_t edge = child[s]; edge != none; edge = sibling[edge]) {
+        row[label[edge]] = value[edge];
+      }
+    } else {
+      uint32_t e = sparse_begin_[order[s]];
+      for (uint32_t edge = child[s]; edge != none; edge = sibling[edge], ++e) {
+        sparse_class_[e] = label[edge];
+        sparse_target_[e] = value[edge];
+      }
+      sparse_fail_[order[s]] = value[fail[s]];
+    }
+  }
+
+  // output indices, dense first
+  std::vector<uint32_t> output_index(states, 0);
+  for (uint32_t s = 0; s < states; ++s) {
+    if (match[s] != none || output[s]) {
+      output_index[s] = depth[s] < dense_depth ? order[s] - first_output_ / class_count_
+                                               : dense_outputs_ + order[s] - (sparse_first_output_ - dense_limit_);
+    }
+  }
+  uint32_t outputs = dense_outputs_ + (sparse_count - (sparse_first_output_ - dense_limit_));
+  match_.assign(outputs, 0);
+  output_link_.assign(outputs, 0);
+  for (uint32_t s = 0; s < states; ++s) {
+    if (match[s] != none || output[s]) {
+      // a state only reaching matches through its suffix reports those
+      uint32_t reported = match[s] != none ? s : output[s];
+      uint32_t shorter = output[reported];
+      match_[output_index[s]] = match[reported];
+      output_link_[output_index[s]] = shorter ? output_index[shorter] + 1 : 0;
+    }
+  }
+}
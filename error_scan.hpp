@@ -0,0 +1,125 @@
+/*
+ * error_scan.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_SCAN_HPP_
+#define ERROR_SCAN_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "error_id.hpp"
+
+// finds the text of error_ids in arbitrary text, e.g. log files, in one pass
+// whatever the number of ids: an Aho-Corasick automaton over all the id
+// strings. the states nearest the start, where a scan spends nearly all its
+// time, are flattened into a table with one row per state and one column
+// per byte class (the bytes that appear in some id, plus "other"); the
+// table is kept within max_table_bytes by storing deeper states sparsely,
+// as their own edges plus a failure link, so that a catalog of tens of
+// thousands of ids costs a few bytes per character of id text rather than
+// a full row per character
+//
+// ids beyond max_text bytes of text in all are left out, see patterns()
+//
+// outside a possible match the scan jumps ahead with SSE2 to the next byte
+// that starts some id, when there are few enough distinct first bytes
+// (SCOPE_ERROR ids start with their group, so there usually are)
+//
+// every occurrence is reported, so where one id's text is a prefix of
+// another's ("GRP-FOO: Foo" and "GRP-FOO: Foo not Bar") both are found
+// ids with the same text are found as whichever was given first
+
+class error_scanner {
+public:
+  // all the ids registered with error_registry so far
+  error_scanner();
+
+  explicit error_scanner(const std::vector<error_value> &ids, size_t max_table_bytes = default_table_bytes);
+
+  // calls f(end, id) for each occurrence, end being one past its last byte
+  // the scanner holds no per-scan state, so threads may share one
+  template <typename F> void scan(const char *begin, const char *end, F f) const {
+    const uint32_t *next = &next_[0];
+    const unsigned char *cls = classes_;
+    uint32_t state = 0;
+    for (const char *p = begin; p != end; ++p) {
+      if (state == 0 && (p = skip(p, end)) == end) {
+        break;
+      }
+      unsigned char c = cls[static_cast<unsigned char>(*p)];
+      state = state < dense_limit_ ? next[state + c] : sparse_next(state, c);
+      if (state >= first_output_) {
+        for (uint32_t o = output_of(state); o; o = output_link_[o - 1]) {
+          f(p + 1, ids_[match_[o - 1]]);
+        }
+      }
+    }
+  }
+
+  // the number of occurrences in [begin, end)
+  size_t count(const char *begin, const char *end) const;
+
+  // the ids searched for, fewer than given if they exceeded max_text
+  size_t patterns() const { return ids_.size(); }
+  size_t states() const { return next_.size() / class_count_ + sparse_fail_.size(); }
+  // the automaton's transitions, dense and sparse
+  size_t table_bytes() const {
+    return next_.size() * sizeof(uint32_t) + sparse_begin_.size() * sizeof(uint32_t)
+           + sparse_class_.size() * (sizeof(unsigned char) + sizeof(uint32_t)) + sparse_fail_.size() * sizeof(uint32_t);
+  }
+
+  static const size_t default_table_bytes = 16 << 20;
+  // keeps every state number, dense or sparse, within 32 bits
+  static const size_t max_dense_bytes = size_t(1) << 30;
+  static const size_t max_text = size_t(1) << 31;
+
+private:
+  void build(const std::vector<error_value> &ids, size_t max_table_bytes);
+
+  // the first byte at or after p that starts an id, or end
+  const char *skip(const char *p, const char *end) const;
+
+  // the transition from a sparse state, following failure links as far as
+  // a state with an edge for c or a dense one
+  uint32_t sparse_next(uint32_t state, unsigned char c) const;
+
+  // one more than the output index of a state at or after first_output_,
+  // 0 for a sparse state not ending a match
+  uint32_t output_of(uint32_t state) const {
+    if (state < dense_limit_) {
+      return (state - first_output_) / class_count_ + 1;
+    }
+    return state >= sparse_first_output_ ? dense_outputs_ + (state - sparse_first_output_) + 1 : 0;
+  }
+
+  std::vector<error_value> ids_;
+  unsigned char classes_[256];
+  unsigned class_count_;
+  // a state is the row offset (row * class_count_, to save the multiply) of
+  // a dense state, or dense_limit_ plus the index of a sparse one. each kind
+  // is ordered so those ending a match come last: dense ones from the row
+  // offset first_output_, making the per-byte check for a dense automaton a
+  // single compare, and sparse ones from sparse_first_output_
+  std::vector<uint32_t> next_;
+  uint32_t dense_limit_;
+  std::vector<uint32_t> sparse_begin_;  // each sparse state's edges, and one past the last
+  std::vector<unsigned char> sparse_class_;
+  std::vector<uint32_t> sparse_target_;
+  std::vector<uint32_t> sparse_fail_;
+  uint32_t sparse_first_output_;
+  // the distinct first bytes of the ids, when few enough for skip()
+  unsigned char starts_[4];
+  unsigned start_count_;
+  uint32_t first_output_;
+  uint32_t dense_outputs_;
+  // by output index, dense outputs first
+  std::vector<uint32_t> match_;        // the id ending at each output state
+  std::vector<uint32_t> output_link_;  // one more than the next shorter match's, or 0
+};
+
+#endif /* ERROR_SCAN_HPP_ */
@@ -0,0 +1,236 @@
+/*
+ * error_scan_main.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// error_scan: counts the error_ids in log files, per id and per time bucket
+//
+//   error_scan [-j threads] [-b bucket_seconds] [-c catalog.tsv] [-i ids.txt] [-l] [-s] file...
+//
+// the ids looked for are those registered in this program (the generated
+// catalog is linked in), those of a catalog file in error_catalog_gen's
+// format (-c) and any given one per line in a text file (-i)
+//
+// files are memory mapped and cut at line ends into chunks, which the
+// threads take in turn; each thread counts into its own table and the
+// tables are merged at the end, so threads share nothing while scanning
+//
+// with -b, each occurrence is counted in the bucket of the timestamp that
+// starts its line ("2026-10-18 09:47:13" or "2026-10-18T09:47:13",
+// optionally after a '['); lines without one are counted under "-"
+// -l counts every SCOPE_ERROR_LOCATION text instead, registered or not, and
+// prints its file, line, group, package and message as separate columns
+// (see error_location.hpp for how a log line is split)
+// -s reports the bytes scanned and throughput on stderr
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "error_id.hpp"
+#include "error_location.hpp"
+#include "error_scan.hpp"
+#include "log_input.hpp"
+
+namespace {
+
+// chunks are cut at the first line end after this many bytes
+const size_t chunk_bytes = 16 << 20;
+
+struct chunk {
+  const char *begin;
+  const char *end;
+};
+
+typedef std::map<std::pair<int64_t, error_value>, unsigned long long> tally;
+typedef std::map<std::pair<int64_t, std::string>, unsigned long long> location_tally;
+
+void fail(const std::string &message) {
+  std::fprintf(stderr, "error_scan: %s\n", message.c_str());
+  std::exit(1);
+}
+
+void scan_chunk(const error_scanner &scanner, const chunk &c, int64_t bucket_seconds, tally &counts) {
+  if (!bucket_seconds) {
+    scanner.scan(c.begin, c.end, [&counts](const char *, error_value id) {
+      ++counts[std::make_pair(log_input::no_time, id)];
+    });
+    return;
+  }
+  // the line of the last match, so a line's timestamp is parsed once
+  const char *line = NULL;
+  int64_t bucket = log_input::no_time;
+  scanner.scan(c.begin, c.end, [&](const char *match_end, error_value id) {
+    const char *start = match_end - std::strlen(id);
+    if (!line || std::memchr(line, '\n', start - line)) {
+      line = log_input::line_start(c.begin, start);
+      int64_t t = log_input::line_time(line, c.end);
+      bucket = t == log_input::no_time ? t : t - t % bucket_seconds;
+    }
+    ++counts[std::make_pair(bucket, id)];
+  });
+}
+
+void scan_locations(const chunk &c, int64_t bucket_seconds, location_tally &counts) {
+  error_location where;
+  for (const char *p = c.begin; (p = error_location::find(p, c.end, where)) != NULL;) {
+    int64_t bucket = log_input::no_time;
+    if (bucket_seconds) {
+      int64_t t = log_input::line_time(log_input::line_start(c.begin, where.file.data), c.end);
+      bucket = t == log_input::no_time ? t : t - t % bucket_seconds;
+    }
+    // the text SCOPE_ERROR_LOCATION would have made, less the trailing space
+    char line[16];
+    std::snprintf(line, sizeof(line), ":%u ", where.line);
+    ++counts[std::make_pair(bucket, where.file.str() + line + where.group.str() + "-" + where.package.str() + ": "
+                                        + where.message.str())];
+  }
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  unsigned threads = std::thread::hardware_concurrency();
+  int64_t bucket_seconds = 0;
+  bool stats = false;
+  bool locations = false;
+  std::vector<error_value> ids;
+  log_input::registered_ids(ids);
+
+  int arg = 1;
+  for (; arg < argc && argv[arg][0] == '-' && argv[arg][1]; ++arg) {
+    std::string option = argv[arg];
+    if (option == "-s") {
+      stats = true;
+    } else if (option == "-l") {
+      locations = true;
+    } else if (arg + 1 < argc && option == "-j") {
+      threads = std::atoi(argv[++arg]);
+    } else if (arg + 1 < argc && option == "-b") {
+      bucket_seconds = std::atoll(argv[++arg]);
+    } else if (arg + 1 < argc && option == "-c") {
+      if (!log_input::read_catalog(argv[++arg], ids)) {
+        fail(std::string("cannot read ") + argv[arg]);
+      }
+    } else if (arg + 1 < argc && option == "-i") {
+      if (!log_input::read_ids(argv[++arg], ids)) {
+        fail(std::string("cannot read ") + argv[arg]);
+      }
+    } else {
+      fail("unknown option " + option);
+    }
+  }
+  if (arg == argc) {
+    std::fprintf(stderr, "usage: error_scan [-j threads] [-b bucket_seconds] [-c catalog.tsv] [-i ids.txt] [-l] [-s] "
+                         "file...\n");
+    return 2;
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  if (bucket_seconds < 0) {
+    fail("the bucket must be a positive number of seconds");
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  error_scanner scanner(ids);
+
+  std::vector<chunk> chunks;
+  unsigned long long bytes = 0;
+  for (; arg < argc; ++arg) {
+    size_t size;
+    bool ok;
+    const char *data = log_input::map(argv[arg], size, ok);
+    if (!ok) {
+      fail(std::string("cannot read ") + argv[arg]);
+    }
+    std::vector<const char *> pieces;
+    log_input::cut(data, size, chunk_bytes, pieces);
+    for (size_t i = 0; i < pieces.size(); i += 2) {
+      chunk c = { pieces[i], pieces[i + 1] };
+      chunks.push_back(c);
+    }
+    bytes += size;
+  }
+
+  std::vector<tally> counts(threads);
+  std::vector<location_tally> location_counts(threads);
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.push_back(std::thread([&, t]() {
+      for (size_t c = next++; c < chunks.size(); c = next++) {
+        if (locations) {
+          scan_locations(chunks[c], bucket_seconds, location_counts[t]);
+        } else {
+          scan_chunk(scanner, chunks[c], bucket_seconds, counts[t]);
+        }
+      }
+    }));
+  }
+  for (unsigned t = 0; t < threads; ++t) {
+    workers[t].join();
+  }
+
+  tally total;
+  for (unsigned t = 0; t < threads; ++t) {
+    for (tally::const_iterator i = counts[t].begin(); i != counts[t].end(); ++i) {
+      total[i->first] += i->second;
+    }
+  }
+  // the location texts, kept for the rows to point at
+  std::set<std::string> texts;
+  for (unsigned t = 0; t < threads; ++t) {
+    for (location_tally::const_iterator i = location_counts[t].begin(); i != location_counts[t].end(); ++i) {
+      error_value text = texts.insert(i->first.second).first->c_str();
+      total[std::make_pair(i->first.first, text)] += i->second;
+    }
+  }
+
+  // by bucket, then most frequent first
+  std::vector<std::pair<std::pair<int64_t, unsigned long long>, error_value> > rows;
+  for (tally::const_iterator i = total.begin(); i != total.end(); ++i) {
+    rows.push_back(std::make_pair(std::make_pair(i->first.first, i->second), i->first.second));
+  }
+  std::sort(rows.begin(), rows.end(), [](const std::pair<std::pair<int64_t, unsigned long long>, error_value> &a,
+                                         const std::pair<std::pair<int64_t, unsigned long long>, error_value> &b) {
+    if (a.first.first != b.first.first) {
+      return a.first.first < b.first.first;
+    }
+    if (a.first.second != b.first.second) {
+      return a.first.second > b.first.second;
+    }
+    return std::strcmp(a.second, b.second) < 0;
+  });
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (bucket_seconds) {
+      std::printf("%s\t", log_input::format_time(rows[r].first.first).c_str());
+    }
+    error_location where;
+    if (locations && error_location::parse(rows[r].second, where)) {
+      std::printf("%llu\t%s\t%u\t%s\t%s\t%s\n", rows[r].first.second, where.file.str().c_str(), where.line,
+                  where.group.str().c_str(), where.package.str().c_str(), where.message.str().c_str());
+    } else {
+      std::printf("%llu\t%s\n", rows[r].first.second, rows[r].second);
+    }
+  }
+
+  if (stats) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu ids, %zu states (%zu KB table), %llu bytes in %zu chunks on %u threads: %.3fs, %.1f MB/s\n",
+                 scanner.patterns(), scanner.states(), scanner.table_bytes() / 1024, bytes, chunks.size(), threads,
+                 seconds, bytes / seconds / 1e6);
+  }
+  return 0;
+}
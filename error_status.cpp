@@ -0,0 +1,130 @@
+/*
+ * error_status.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "error_status.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+#if defined(__SSE2__)
+
+const size_t lanes = 8;
+
+// bit 2i (and 2i + 1) of the mask is set when index i is non zero
+inline unsigned failed_mask(const uint16_t *p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  return ~_mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_setzero_si128())) & 0xFFFFu;
+}
+
+// counts the successes a lane at a time, in 16 bit counters flushed before
+// they can overflow, rather than a popcount per step
+size_t count_failed(const uint16_t *p, size_t n) {
+  const size_t flush = 0x8000 * lanes;
+  size_t succeeded = 0;
+  size_t i = 0;
+  while (i + lanes <= n) {
+    size_t end = n - (n - i) % lanes;
+    if (end - i > flush) {
+      end = i + flush;
+    }
+    __m128i zeros = _mm_setzero_si128();
+    for (; i < end; i += lanes) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(v, _mm_setzero_si128()));
+    }
+    uint16_t counts[lanes];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(counts), zeros);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      succeeded += counts[lane];
+    }
+  }
+  for (; i < n; ++i) {
+    succeeded += p[i] == 0;
+  }
+  return n - succeeded;
+}
+
+#else
+
+const size_t lanes = 4;
+
+// the top bit of each 16 bit lane is set when that index is non zero
+inline uint64_t failed_mask(const uint16_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  const uint64_t high = 0x8000800080008000ull;
+  return (((v & ~high) + ~high) | v) & high;
+}
+
+size_t count_failed(const uint16_t *p, size_t n) {
+  size_t failed = 0;
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    // one bit per failed lane, summed into the top byte by the multiply
+    failed += ((failed_mask(p + i) >> 15) * 0x0001000100010001ull) >> 48;
+  }
+  for (; i < n; ++i) {
+    failed += p[i] != 0;
+  }
+  return failed;
+}
+
+#endif
+
+}
+
+bool error_status_column::set(size_t row, error_value err) {
+  unsigned index = err ? error_registry::add(err) : 0;
+  if (err && !index) {
+    return false;
+  }
+  indices_[row] = static_cast<uint16_t>(index);
+  return true;
+}
+
+void error_status_column::clear_all() { std::fill(indices_.begin(), indices_.end(), 0); }
+
+bool error_status_column::any() const {
+  const uint16_t *p = data();
+  size_t n = size();
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    if (failed_mask(p + i)) {
+      return true;
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t error_status_column::count() const { return count_failed(data(), size()); }
+
+size_t error_status_column::next_error(size_t from) const {
+  const uint16_t *p = data();
+  size_t n = size();
+  size_t i = from;
+  // skip whole steps of successes, then find the row one at a time
+  while (i + lanes <= n && !failed_mask(p + i)) {
+    i += lanes;
+  }
+  for (; i < n; ++i) {
+    if (p[i]) {
+      return i;
+    }
+  }
+  return n;
+}
@@ -0,0 +1,73 @@
+/*
+ * error_status.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_STATUS_HPP_
+#define ERROR_STATUS_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "error_id.hpp"
+#include "error_registry.hpp"
+
+// a status per row for batch operations, held as the 16 bit registry index
+// of the row's error_id with 0 for success - a quarter of the bandwidth of
+// an error_value per row, and since nearly every row succeeds the scans
+// below look at 8 (SSE2) or 4 (otherwise) rows per step and skip straight
+// over runs of successes
+//
+//   error_status_column status(rows.size());
+//   ...
+//   if (status.any()) {
+//     status.for_each_error([&](size_t row, error_value err) { ... });
+//   }
+
+class error_status_column {
+public:
+  explicit error_status_column(size_t rows = 0) : indices_(rows, 0) {}
+
+  size_t size() const { return indices_.size(); }
+  void resize(size_t rows) { indices_.resize(rows, 0); }
+
+  // marks row failed with err, registering it on first sight
+  // returns false (leaving the row alone) if the registry is full
+  bool set(size_t row, error_value err);
+
+  void clear(size_t row) { indices_[row] = 0; }
+  void clear_all();
+
+  bool failed(size_t row) const { return indices_[row] != 0; }
+
+  // the row's error_value, NULL for success
+  error_value at(size_t row) const { return indices_[row] ? error_registry::at(indices_[row]) : NULL; }
+
+  // the raw registry index, for passing the column on as it is
+  uint16_t index(size_t row) const { return indices_[row]; }
+  const uint16_t *data() const { return indices_.empty() ? NULL : &indices_[0]; }
+
+  // whether any row failed
+  bool any() const;
+
+  // the number of failed rows
+  size_t count() const;
+
+  // the first failed row at or after from, size() if there is none
+  size_t next_error(size_t from) const;
+
+  // calls f(row, error_value) for each failed row in order
+  template <typename F> void for_each_error(F f) const {
+    for (size_t row = next_error(0); row < size(); row = next_error(row + 1)) {
+      f(row, error_registry::at(indices_[row]));
+    }
+  }
+
+private:
+  std::vector<uint16_t> indices_;
+};
+
+#endif /* ERROR_STATUS_HPP_ */
@@ -0,0 +1,315 @@
+/*
+ * error_task.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef ERROR_TASK_HPP_
+#define ERROR_TASK_HPP_
+
+#if __cplusplus < 202002L
+#error "error_task.hpp requires C++20 (coroutines)"
+#endif
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "error_id.hpp"
+#include "error_result.hpp"
+
+// coroutines whose failures are error_values rather than exceptions
+//
+// inside an error_task, co_await on an error_result<U> gives the U, and on
+// an error_value gives nothing, unless they hold an error: then the task
+// completes there and then with that error, and so does every error_task
+// awaiting it in turn, up to the first that is not - no exception is
+// thrown and nothing after the co_await runs. The frames stay suspended
+// until their owners destroy them, which runs their destructors as usual
+//
+//   error_task<size_t> load(const char *path) {
+//     int fd = co_await open_file(path);            // error_result<int>
+//     size_t n = co_await read_all(fd);             // error_task<size_t>
+//     co_await (n ? NULL : GRP_IO::eEMPTY);         // error_value
+//     co_return n;
+//   }
+//
+// co_await std::move(task).outcome() instead gives the error_result, for
+// a caller that handles the failure itself. Tasks start when awaited, or
+// with run(); any other awaitable can be awaited as usual, and whoever
+// resumes the task after it takes it on from there. Tasks must not throw
+//
+// frames come from error_frame_pool, which keeps freed frames per thread
+// for reuse, so a steady stream of tasks does not touch the heap. A frame
+// goes to the list of the thread that frees it, which is capped, so tasks
+// made on one thread and finished on another fall back to the heap
+
+class error_frame_pool {
+public:
+  // frames up to classes * granule bytes are recycled, larger ones are not
+  static const std::size_t granule = 64;
+  static const std::size_t classes = 16;
+  // freed frames kept per size class and thread, the rest are deleted
+  static const std::size_t cached = 32;
+
+  static void *allocate(std::size_t bytes) {
+    std::size_t size_class = (bytes - 1) / granule;
+    if (size_class < classes) {
+      free_frame *&head = local().heads[size_class];
+      if (head) {
+        free_frame *frame = head;
+        head = frame->next;
+        --local().counts[size_class];
+        return frame;
+      }
+      return ::operator new((size_class + 1) * granule);
+    }
+    return ::operator new(bytes);
+  }
+
+  static void deallocate(void *p, std::size_t bytes) {
+    std::size_t size_class = (bytes - 1) / granule;
+    if (size_class < classes && local().counts[size_class] < cached) {
+      free_frame *frame = static_cast<free_frame *>(p);
+      free_frame *&head = local().heads[size_class];
+      frame->next = head;
+      head = frame;
+      ++local().counts[size_class];
+      return;
+    }
+    ::operator delete(p);
+  }
+
+  // how many freed frames of this size this thread is holding
+  static std::size_t kept(std::size_t bytes) {
+    std::size_t size_class = (bytes - 1) / granule;
+    return size_class < classes ? local().counts[size_class] : 0;
+  }
+
+private:
+  struct free_frame {
+    free_frame *next;
+  };
+
+  struct lists {
+    free_frame *heads[classes] = {};
+    std::size_t counts[classes] = {};
+
+    ~lists() {
+      for (std::size_t c = 0; c < classes; ++c) {
+        while (free_frame *frame = heads[c]) {
+          heads[c] = frame->next;
+          ::operator delete(frame);
+        }
+      }
+    }
+  };
+
+  static lists &local() {
+    static thread_local lists frames;
+    return frames;
+  }
+};
+
+template <typename T> class error_task;
+
+class error_task_promise_base {
+public:
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  struct final_awaiter {
+    bool await_ready() noexcept { return false; }
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> done) noexcept {
+      error_task_promise_base &promise = done.promise();
+      promise.finished_ = true;
+      if (promise.error_ && promise.parent_) {
+        return promise.parent_->fail(promise.error_);
+      }
+      return promise.resume_next();
+    }
+    void await_resume() noexcept {}
+  };
+
+  final_awaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() noexcept { std::terminate(); }
+
+  static void *operator new(std::size_t bytes) { return error_frame_pool::allocate(bytes); }
+  static void operator delete(void *p, std::size_t bytes) { error_frame_pool::deallocate(p, bytes); }
+
+  // co_await on a failure completes the task, and those awaiting it
+  template <typename U> auto await_transform(error_result<U> result) {
+    struct awaiter {
+      error_result<U> result;
+      error_task_promise_base *self;
+      bool await_ready() noexcept { return result.ok(); }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept { return self->fail(result.error()); }
+      U await_resume() { return std::move(result.value()); }
+    };
+    return awaiter{ std::move(result), this };
+  }
+
+  auto await_transform(error_value err) {
+    struct awaiter {
+      error_value err;
+      error_task_promise_base *self;
+      bool await_ready() noexcept { return err == NULL; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept { return self->fail(err); }
+      void await_resume() noexcept {}
+    };
+    return awaiter{ err, this };
+  }
+
+  template <typename U> auto await_transform(error_task<U> &&child) {
+    struct awaiter {
+      error_task<U> child;
+      error_task_promise_base *self;
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiting) noexcept {
+        child.handle_.promise().continuation_ = waiting;
+        child.handle_.promise().parent_ = self;
+        return child.handle_;
+      }
+      U await_resume() { return child.handle_.promise().take(); }
+    };
+    return awaiter{ std::move(child), this };
+  }
+
+  // anything else is awaited as it is
+  template <typename A> A &&await_transform(A &&awaitable) { return std::forward<A>(awaitable); }
+
+protected:
+  template <typename> friend class error_task;
+
+  // completes this task and the error_tasks awaiting it with err, and
+  // returns what runs next
+  std::coroutine_handle<> fail(error_value err) noexcept {
+    error_task_promise_base *promise = this;
+    for (;;) {
+      promise->error_ = err;
+      promise->finished_ = true;
+      if (!promise->parent_) {
+        return promise->resume_next();
+      }
+      promise = promise->parent_;
+    }
+  }
+
+  std::coroutine_handle<> resume_next() noexcept {
+    return continuation_ ? continuation_ : std::noop_coroutine();
+  }
+
+  error_value error_ = NULL;
+  bool finished_ = false;
+  std::coroutine_handle<> continuation_;
+  error_task_promise_base *parent_ = NULL;  // an error_task failing with this one
+};
+
+template <typename T> class error_task_promise : public error_task_promise_base {
+public:
+  // co_return a T, or error_fail(err)
+  void return_value(error_result<T> result) {
+    if (result.ok()) {
+      value_.emplace(std::move(result.value()));
+    } else {
+      error_ = result.error();
+    }
+  }
+
+  T take() { return std::move(*value_); }
+
+  // the value copied, it stays in the promise
+  error_result<T> outcome() const {
+    if (error_) {
+      return error_result<T>(error_fail(error_));
+    }
+    return error_result<T>(*value_);
+  }
+
+  // the value moved out, once
+  error_result<T> take_outcome() {
+    if (error_) {
+      return error_result<T>(error_fail(error_));
+    }
+    return error_result<T>(std::move(*value_));
+  }
+
+private:
+  std::optional<T> value_;
+};
+
+// error_result<void> does not exist, so void tasks report just the error
+template <> class error_task_promise<void> : public error_task_promise_base {
+public:
+  void return_void() noexcept {}
+  void take() noexcept {}
+  error_value outcome() const noexcept { return error_; }
+  error_value take_outcome() noexcept { return error_; }
+};
+
+template <typename T> class [[nodiscard]] error_task {
+public:
+  struct promise_type : error_task_promise<T> {
+    error_task get_return_object() { return error_task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+  };
+
+  typedef typename std::conditional<std::is_void<T>::value, error_value, error_result<T> >::type outcome_type;
+
+  error_task(error_task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  error_task(const error_task &) = delete;
+  error_task &operator=(const error_task &) = delete;
+
+  ~error_task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  // starts the task on this thread and returns once it has finished or is
+  // waiting on something else
+  void start() { handle_.resume(); }
+
+  bool done() const { return handle_.promise().finished_; }
+
+  // once done(): the value or error (just the error for void tasks), the
+  // value copied so it can be asked for again
+  outcome_type outcome() const & { return handle_.promise().outcome(); }
+
+  // the task run to its end, for tasks awaiting nothing but error_tasks
+  // and results; the value is moved out
+  outcome_type run() {
+    start();
+    // a task suspended on some other awaitable has no outcome yet
+    assert(done());
+    return handle_.promise().take_outcome();
+  }
+
+  // awaited in another error_task, gives the outcome, failure or not
+  auto outcome() && {
+    struct awaiter {
+      error_task task;
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiting) noexcept {
+        task.handle_.promise().continuation_ = waiting;
+        return task.handle_;
+      }
+      outcome_type await_resume() { return task.handle_.promise().take_outcome(); }
+    };
+    return awaiter{ std::move(*this) };
+  }
+
+private:
+  friend class error_task_promise_base;
+
+  explicit error_task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+#endif /* ERROR_TASK_HPP_ */
@@ -0,0 +1,187 @@
+/*
+ * except_fmt.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef EXCEPT_FMT_HPP_
+#define EXCEPT_FMT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include "except_id.hpp"
+
+// a typed error whose description is only formatted when what() is first
+// called - the format string (which must be a literal) and the arguments are
+// captured by value, so a throw caught by code which only checks type() never
+// pays for the formatting
+
+// bytes kept inline for each captured string argument, longer ones are cut
+// short and end in "..."
+
+#ifndef ERROR_ID_FMT_CONTEXT
+#define ERROR_ID_FMT_CONTEXT 64
+#endif
+
+// bytes available for the formatted description
+#ifndef ERROR_ID_FMT_TEXT
+#define ERROR_ID_FMT_TEXT 256
+#endif
+
+// string arguments are copied, so they cannot dangle once the throw unwinds
+class fmt_context_str {
+public:
+  explicit fmt_context_str(const char *s) { assign(s ? s : "(null)", s ? std::strlen(s) : 6); }
+  explicit fmt_context_str(const std::string &s) { assign(s.data(), s.size()); }
+
+  const char *c_str() const { return text_; }
+
+private:
+  void assign(const char *s, std::size_t len) {
+    if (len >= sizeof(text_)) {
+      std::memcpy(text_, s, sizeof(text_) - 4);
+      std::memcpy(text_ + sizeof(text_) - 4, "...", 4);
+      return;
+    }
+    std::memcpy(text_, s, len);
+    text_[len] = '\0';
+  }
+
+  char text_[ERROR_ID_FMT_CONTEXT];
+};
+
+// maps each argument type to its captured form, and back to a printf argument
+template <typename T> struct fmt_capture {
+  typedef T type;
+  static const T &arg(const T &t) { return t; }
+};
+
+template <> struct fmt_capture<const char *> {
+  typedef fmt_context_str type;
+  static const char *arg(const fmt_context_str &s) { return s.c_str(); }
+};
+
+template <> struct fmt_capture<char *> : fmt_capture<const char *> {};
+
+template <> struct fmt_capture<std::string> : fmt_capture<const char *> {};
+
+// the type captured for a deduced argument: arrays and char* decay to const char*
+template <typename T> struct fmt_param {
+  typedef typename std::decay<T>::type type;
+};
+
+template <std::size_t N> struct fmt_param<char[N]> {
+  typedef const char *type;
+};
+
+template <> struct fmt_param<char *> {
+  typedef const char *type;
+};
+
+// only what printf can take may be captured: passing a class type through
+// the varargs of snprintf would compile, and be undefined
+template <typename T> struct fmt_printable {
+  static const bool value = std::is_arithmetic<T>::value || std::is_pointer<T>::value
+                            || std::is_same<T, fmt_context_str>::value;
+};
+
+template <typename... T> struct fmt_printable_all : std::true_type {};
+
+template <typename T, typename... Rest>
+struct fmt_printable_all<T, Rest...>
+    : std::integral_constant<bool, fmt_printable<T>::value && fmt_printable_all<Rest...>::value> {};
+
+template <std::size_t... I> struct fmt_indices {};
+
+template <std::size_t N, std::size_t... I>
+struct fmt_make_indices : fmt_make_indices<N - 1, N - 1, I...> {};
+
+template <std::size_t... I> struct fmt_make_indices<0, I...> {
+  typedef fmt_indices<I...> type;
+};
+
+// caught as typed_error_lite<errtype> (or typed_error_base) by handlers that
+// do not care about the captured arguments
+template <error_id errtype, typename... Args>
+class typed_error_fmt : public typed_error_lite<errtype> {
+  static_assert(fmt_printable_all<typename fmt_capture<Args>::type...>::value,
+                "typed_error_fmt arguments must be arithmetic, pointers or strings");
+
+public:
+  typed_error_fmt(const char *fmt, const Args &... args)
+      : fmt_(fmt), args_(typename fmt_capture<Args>::type(args)...), state_(unformatted) {}
+
+  // the copy formats afresh on demand, the text is not carried across
+  typed_error_fmt(const typed_error_fmt &other)
+      : typed_error_lite<errtype>(other), fmt_(other.fmt_), args_(other.args_), state_(unformatted) {}
+
+  // formats on the first call, safe to call from several threads at once
+  const char *what() const noexcept {
+    int state = state_.load(std::memory_order_acquire);
+    if (state != formatted) {
+      if (state == unformatted
+          && state_.compare_exchange_strong(state, formatting, std::memory_order_acquire)) {
+        format(typename fmt_make_indices<sizeof...(Args)>::type());
+        state_.store(formatted, std::memory_order_release);
+      } else {
+        while (state_.load(std::memory_order_acquire) != formatted) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    return text_;
+  }
+
+  const char *format_string() const { return fmt_; }
+
+private:
+  enum { unformatted, formatting, formatted };
+
+  template <std::size_t... I> void format(fmt_indices<I...>) const {
+    std::snprintf(text_, sizeof(text_), fmt_, fmt_capture<Args>::arg(std::get<I>(args_))...);
+  }
+
+  // without arguments the string is taken literally, as typed_error would
+  void format(fmt_indices<>) const {
+    std::snprintf(text_, sizeof(text_), "%s", fmt_);
+  }
+
+  const char *fmt_;
+  std::tuple<typename fmt_capture<Args>::type...> args_;
+  mutable std::atomic<int> state_;
+  mutable char text_[ERROR_ID_FMT_TEXT];
+};
+
+// deduces the argument types, so that
+//   throw make_typed_error<FooErrors::eFOO>("cannot open %s (%d)", name, rc);
+// captures name and rc and defers the formatting
+template <error_id errtype, typename... Args>
+inline typed_error_fmt<errtype, typename fmt_param<Args>::type...>
+make_typed_error(const char *fmt, const Args &... args) {
+  return typed_error_fmt<errtype, typename fmt_param<Args>::type...>(fmt, args...);
+}
+
+// the format string is only a const char * to the templates above, so the
+// compiler cannot check it against the arguments; TYPED_ERROR_FMT has it
+// checked as printf's would be (-Wformat), where the compiler can, e.g.
+//   throw TYPED_ERROR_FMT(FooErrors::eFOO, "cannot open %s (%d)", name.c_str(), rc);
+// the check is never called, and std::strings go in as .c_str()
+// string arguments are copied into ERROR_ID_FMT_CONTEXT bytes each, so a
+// longer one is cut short and ends in "..."
+#if defined(__GNUC__) || defined(__clang__)
+int fmt_printf_check(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+#define TYPED_ERROR_FMT(errtype, fmt, ...) \
+  ((void)sizeof(fmt_printf_check(fmt, __VA_ARGS__)), make_typed_error<errtype>(fmt, __VA_ARGS__))
+#else
+#define TYPED_ERROR_FMT(errtype, fmt, ...) make_typed_error<errtype>(fmt, __VA_ARGS__)
+#endif
+
+#endif /* EXCEPT_FMT_HPP_ */
@@ -8,23 +8,116 @@
 #ifndef EXCEPT_ID_HPP_
 #define EXCEPT_ID_HPP_
 
+#include <exception>
 #include <stdexcept>
+#include <type_traits>
+
+#include "error_result.hpp"
+#include "raise_id.hpp"
+
+// common base through which the error_id of any typed exception can be
+// recovered without knowing errtype at the catch site
+class typed_error_base {
+public:
+  virtual ~typed_error_base() {}
+  virtual const char *type() const = 0;
+};
 
 // we can define a simple template parameterised upon the error_id value
-template <error_id errtype> class typed_error_lite : public std::exception {};
+template <error_id errtype>
+class typed_error_lite : public std::exception, public typed_error_base {
+public:
+  const char *type() const { return errtype; }
+};
+
+#if ERROR_ID_HAS_EXCEPTIONS
+// typed_error_lite has no state, so one instance per errtype serves everyone:
+// the exception_ptr is materialised on first use and shared thereafter, so
+// handing the failure to N waiters is N reference count bumps, not N throws
+template <error_id errtype>
+inline const std::exception_ptr &lite_exception_ptr() {
+  static const std::exception_ptr ptr = std::make_exception_ptr(typed_error_lite<errtype>());
+  return ptr;
+}
+#endif
 
 // or we can go a little further and allow for some additional information
 // this one has a base type and additional info
-template <error_id errtype> class typed_error : public std::runtime_error {
+template <error_id errtype>
+class typed_error : public std::runtime_error, public typed_error_base {
 public:
   // be very careful to ensure that what is given a NBTS
-  typed_error(const char* what = errtype): std::runtime_error(what) {}
+  typed_error(const char* what = errtype): std::runtime_error(what) {
+    ERROR_ID_PROBE(typed_error, errtype);
+  }
 
   const char *type() const { return errtype; }
   operator const char *() { return errtype; }
 };
 
+// raise a typed_error<errtype> carrying the given description
+// without exceptions the error_id and description go to the raise handler
+// and no exception object is ever constructed
+template <error_id errtype>
+[[noreturn]] inline void raise_typed(const char* what = errtype) {
+  ERROR_ID_PROBE(raise, errtype);
+#if ERROR_ID_HAS_EXCEPTIONS
+  throw typed_error<errtype>(what);
+#else
+  get_error_raise_handler()(errtype, what);
+  std::abort();
+#endif
+}
+
+// invoke the callable, returning its error_id rather than letting an exception
+// escape: typed errors map to their errtype, raw error_id throws to themselves
+// and anything else to the designated internal_err
+// callables returning anything that converts to error_value have that value
+// passed through, those returning an error_result<T> its error(); any other
+// return value is discarded and success is reported as NULL
+// the try block is table driven, so the non-throwing path costs nothing
+struct error_boundary_returns_void {};
+struct error_boundary_returns_error {};
+struct error_boundary_returns_other {};
+
+template <typename T>
+inline error_value error_boundary_error_of(const error_result<T> &result) { return result.error(); }
+
+template <typename T>
+inline error_value error_boundary_error_of(const T &) { return NULL; }
+
+template <typename F>
+inline error_value error_boundary_call(F &f, error_boundary_returns_error) { return f(); }
+
+template <typename F>
+inline error_value error_boundary_call(F &f, error_boundary_returns_other) { return error_boundary_error_of(f()); }
 
+template <typename F>
+inline error_value error_boundary_call(F &f, error_boundary_returns_void) {
+  f();
+  return NULL;
+}
 
+template <error_id internal_err, typename F>
+inline error_value error_boundary(F &&f) noexcept {
+  typedef typename std::decay<decltype(f())>::type result_type;
+  typedef typename std::conditional<
+      std::is_void<result_type>::value, error_boundary_returns_void,
+      typename std::conditional<std::is_convertible<result_type, error_value>::value, error_boundary_returns_error,
+                                error_boundary_returns_other>::type>::type returns;
+#if ERROR_ID_HAS_EXCEPTIONS
+  try {
+    return error_boundary_call(f, returns());
+  } catch (const typed_error_base &e) {
+    return e.type();
+  } catch (error_value e) {
+    return e ? e : internal_err;
+  } catch (...) {
+    return internal_err;
+  }
+#else
+  return error_boundary_call(f, returns());
+#endif
+}
 
 #endif /* EXCEPT_ID_HPP_ */
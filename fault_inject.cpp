@@ -0,0 +1,177 @@
+/*
+ * fault_inject.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "fault_inject.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "error_registry.hpp"
+
+std::atomic<bool> fault_injection::active(false);
+
+struct fault_injection::slot {
+  char name[max_name];
+  std::atomic<error_value> err;
+  // probability scaled so that 1.0 == 2^32, compared with a 32 bit draw
+  std::atomic<uint64_t> threshold;
+  std::atomic<uint64_t> fired;
+};
+
+namespace {
+
+fault_injection::slot slots[fault_injection::max_sites];
+std::atomic<unsigned> slot_count(0);
+std::mutex slot_lock;
+
+// finds or creates the named slot, NULL if the table is full or the name
+// too long to be kept whole (cut short, it could match another site's)
+// callers hold slot_lock
+fault_injection::slot *find_slot(const char *name, bool create) {
+  size_t length = std::strlen(name);
+  if (length >= fault_injection::max_name) {
+    return NULL;
+  }
+  unsigned count = slot_count.load(std::memory_order_relaxed);
+  for (unsigned i = 0; i < count; ++i) {
+    if (!std::strcmp(slots[i].name, name)) {
+      return &slots[i];
+    }
+  }
+  if (!create || count == fault_injection::max_sites) {
+    return NULL;
+  }
+  fault_injection::slot *s = &slots[count];
+  std::memcpy(s->name, name, length + 1);
+  s->err.store(NULL, std::memory_order_relaxed);
+  s->threshold.store(0, std::memory_order_relaxed);
+  s->fired.store(0, std::memory_order_relaxed);
+  slot_count.store(count + 1, std::memory_order_release);
+  return s;
+}
+
+uint32_t next_random() {
+  // xorshift is plenty for deciding whether to fail
+  static thread_local uint32_t state = 0;
+  if (state == 0) {
+    state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state)) | 1;
+  }
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+uint64_t scale(double probability) {
+  if (probability <= 0) {
+    return 0;
+  }
+  if (probability >= 1) {
+    return 1ull << 32;
+  }
+  return static_cast<uint64_t>(probability * 4294967296.0);
+}
+
+error_value registered_by_text(const std::string &text) {
+  for (unsigned index = 1; index <= error_registry::size(); ++index) {
+    error_value id = error_registry::at(index);
+    if (text == id) {
+      return id;
+    }
+  }
+  return NULL;
+}
+
+}
+
+bool fault_injection::arm(const char *site_name, error_value err, double probability) {
+  std::lock_guard<std::mutex> lock(slot_lock);
+  slot *s = find_slot(site_name, true);
+  if (!s) {
+    return false;
+  }
+  s->threshold.store(scale(probability), std::memory_order_relaxed);
+  s->err.store(err, std::memory_order_release);
+  return true;
+}
+
+void fault_injection::disarm(const char *site_name) {
+  std::lock_guard<std::mutex> lock(slot_lock);
+  slot *s = find_slot(site_name, false);
+  if (s) {
+    s->err.store(NULL, std::memory_order_release);
+  }
+}
+
+void fault_injection::disarm_all() {
+  std::lock_guard<std::mutex> lock(slot_lock);
+  unsigned count = slot_count.load(std::memory_order_relaxed);
+  for (unsigned i = 0; i < count; ++i) {
+    slots[i].err.store(NULL, std::memory_order_release);
+  }
+}
+
+unsigned fault_injection::configure(const char *spec) {
+  unsigned armed = 0;
+  std::string entries(spec ? spec : "");
+  std::string::size_type start = 0;
+  while (start < entries.size()) {
+    std::string::size_type end = entries.find(';', start);
+    if (end == std::string::npos) {
+      end = entries.size();
+    }
+    std::string entry = entries.substr(start, end - start);
+    start = end + 1;
+
+    std::string::size_type equals = entry.find('=');
+    std::string::size_type colon = entry.find(':', equals);
+    if (equals == std::string::npos || colon == std::string::npos) {
+      continue;
+    }
+    error_value err = registered_by_text(entry.substr(colon + 1));
+    if (!err) {
+      continue;
+    }
+    double probability = std::strtod(entry.substr(equals + 1, colon - equals - 1).c_str(), NULL);
+    if (arm(entry.substr(0, equals).c_str(), err, probability)) {
+      ++armed;
+    }
+  }
+  if (armed) {
+    enable();
+  }
+  return armed;
+}
+
+uint64_t fault_injection::fired(const char *site_name) {
+  std::lock_guard<std::mutex> lock(slot_lock);
+  slot *s = find_slot(site_name, false);
+  return s ? s->fired.load(std::memory_order_relaxed) : 0;
+}
+
+fault_injection::site::site(const char *name) : slot_(NULL) {
+  std::lock_guard<std::mutex> lock(slot_lock);
+  slot_ = find_slot(name, true);
+}
+
+error_value fault_injection::site::fire() {
+  if (!slot_) {
+    return NULL;
+  }
+  error_value err = slot_->err.load(std::memory_order_acquire);
+  if (!err) {
+    return NULL;
+  }
+  uint64_t threshold = slot_->threshold.load(std::memory_order_relaxed);
+  if (threshold <= next_random()) {
+    return NULL;
+  }
+  slot_->fired.fetch_add(1, std::memory_order_relaxed);
+  return err;
+}
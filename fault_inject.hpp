@@ -0,0 +1,95 @@
+/*
+ * fault_inject.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef FAULT_INJECT_HPP_
+#define FAULT_INJECT_HPP_
+
+#include <atomic>
+#include <stdint.h>
+
+#include "error_id.hpp"
+
+// named fault injection points which make a site report a chosen error_id:
+//
+//   error_value LibA::do_work() {
+//     if (error_value err = ERROR_ID_INJECT("LibA.do_work")) {
+//       return err;
+//     }
+//     ...
+//
+// with injection switched off a site costs one relaxed load of a global flag
+// and a branch predicted not taken; everything else (finding the site's
+// settings, the random draw) is behind that branch
+//
+// sites are armed by name, before or after they are first reached:
+//   fault_injection::arm("LibA.do_work", FooErrors::ePOR, 0.25);
+//   fault_injection::enable();
+// or from text, e.g. an environment variable, where ids are looked up by
+// their string among the registered error_ids:
+//   fault_injection::configure("LibA.do_work=0.25:GRP-FOO: Foo not reparable");
+
+class fault_injection {
+public:
+  // the one flag tested on the hot path
+  static std::atomic<bool> active;
+
+  static void enable() { active.store(true, std::memory_order_relaxed); }
+  static void disable() { active.store(false, std::memory_order_relaxed); }
+
+  // the site will report err with the given probability (0..1) once enabled
+  // returns false if the table of sites is full, or the name is max_name
+  // bytes or longer
+  static bool arm(const char *site, error_value err, double probability = 1.0);
+
+  // the site goes back to reporting nothing
+  static void disarm(const char *site);
+  static void disarm_all();
+
+  // arms sites from "site=probability:error text" entries separated by ';'
+  // the error text must match a registered error_id; returns the number of
+  // sites armed, and enables injection if that is not 0
+  static unsigned configure(const char *spec);
+
+  // how many times the site has injected its error
+  static uint64_t fired(const char *site);
+
+  struct slot;
+
+  // a site's link to its settings, created the first time it is reached
+  // while injection is active; a site named max_name bytes or longer
+  // never fires
+  class site {
+  public:
+    explicit site(const char *name);
+    error_value fire();
+
+  private:
+    slot *slot_;
+  };
+
+  static const unsigned max_sites = 256;
+  static const unsigned max_name = 64;
+};
+
+#if defined(__GNUC__)
+#define ERROR_ID_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define ERROR_ID_UNLIKELY(x) (x)
+#endif
+
+// evaluates to the error_id to inject at this site, or NULL
+#define ERROR_ID_INJECT(name)                                                        \
+  (ERROR_ID_UNLIKELY(fault_injection::active.load(std::memory_order_relaxed))       \
+       ? []() -> error_value {                                                       \
+           static_assert(sizeof(name) <= fault_injection::max_name,                  \
+                         "fault injection site name too long");                      \
+           static fault_injection::site fault_site(name);                            \
+           return fault_site.fire();                                                 \
+         }()                                                                         \
+       : static_cast<error_value>(NULL))
+
+#endif /* FAULT_INJECT_HPP_ */
@@ -7,6 +7,8 @@
 
 #include "fooerrors.h"
 
+#include "raise_id.hpp"
+
 // this is a hand-crafted error definition
 error_id FooErrors::eFOO = "GRP-FOO: Foo clobbered BAR on use";
 // and these use the convenience macro
@@ -15,4 +17,4 @@ error_id FooErrors::ePOR = SCOPE_ERROR("GRP", "FOO", "Foo not reparable");
 
 const char *FooErrors::eFOO2 = "GRP-FOO: Foo clobbered BAR on use";
 
-void throw_eFOO() { throw FooErrors::eFOO; }
+void throw_eFOO() { raise_id(FooErrors::eFOO); }
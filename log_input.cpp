@@ -0,0 +1,189 @@
+/*
+ * log_input.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "log_input.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "error_catalog.hpp"
+#include "error_catalog_tsv.hpp"
+#include "error_registry.hpp"
+
+namespace {
+
+// ids read from files live as long as the program
+error_value own(const std::string &text) {
+  static std::vector<std::string *> owned;
+  owned.push_back(new std::string(text));
+  return owned.back()->c_str();
+}
+
+bool digits(const char *p, unsigned n, int &value) {
+  value = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    if (p[i] < '0' || p[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (p[i] - '0');
+  }
+  return true;
+}
+
+// days since 1970-01-01 of a proleptic Gregorian date, and back
+int64_t days_from_civil(int y, int m, int d) {
+  y -= m <= 2;
+  int64_t era = (y >= 0 ? y : y - 399) / 400;
+  int64_t yoe = y - era * 400;
+  int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+void civil_from_days(int64_t days, int64_t &y, int &m, int &d) {
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t doe = days - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t mp = (5 * doy + 2) / 153;
+  d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  y = yoe + era * 400 + (m <= 2);
+}
+
+}
+
+const int64_t log_input::no_time;
+
+void log_input::registered_ids(std::vector<error_value> &ids) {
+  unsigned size = error_registry::size();
+  for (unsigned index = 1; index <= size; ++index) {
+    ids.push_back(error_registry::at(index));
+  }
+}
+
+bool log_input::read_catalog(const char *path, std::vector<error_value> &ids, std::vector<uint32_t> *codes) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::string line;
+  std::vector<std::string> fields;
+  while (std::getline(in, line)) {
+    // rows error_catalog_gen would reject are skipped
+    uint32_t code;
+    if (!error_catalog_fields(line, fields) || fields.size() < error_catalog_min_columns
+        || fields.size() > error_catalog_max_columns || !error_catalog_row_code(fields, code)) {
+      continue;
+    }
+    ids.push_back(own(fields[error_catalog_group] + "-" + fields[error_catalog_package] + ": "
+                      + fields[error_catalog_message]));
+    if (codes) {
+      codes->push_back(code);
+    }
+  }
+  return true;
+}
+
+bool log_input::read_ids(const char *path, std::vector<error_value> &ids) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line[line.size() - 1] == '\r') {
+      line.erase(line.size() - 1);
+    }
+    if (!line.empty()) {
+      ids.push_back(own(line));
+    }
+  }
+  return true;
+}
+
+const char *log_input::map(const char *path, size_t &size, bool &ok) {
+  size = 0;
+  ok = false;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat st;
+  void *data = MAP_FAILED;
+  if (fstat(fd, &st) == 0) {
+    ok = true;
+    if (st.st_size > 0) {
+      data = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      ok = data != MAP_FAILED;
+    }
+  }
+  // the mapping outlives the descriptor
+  close(fd);
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+  size = static_cast<size_t>(st.st_size);
+  madvise(data, size, MADV_SEQUENTIAL);
+  return static_cast<const char *>(data);
+}
+
+void log_input::cut(const char *data, size_t size, size_t chunk_bytes, std::vector<const char *> &pieces) {
+  const char *p = data;
+  const char *end = data + size;
+  while (p != end) {
+    const char *cut = static_cast<size_t>(end - p) > chunk_bytes ? p + chunk_bytes : end;
+    const char *newline = static_cast<const char *>(std::memchr(cut, '\n', end - cut));
+    cut = newline ? newline + 1 : end;
+    pieces.push_back(p);
+    pieces.push_back(cut);
+    p = cut;
+  }
+}
+
+int64_t log_input::line_time(const char *line, const char *end) {
+  if (line != end && *line == '[') {
+    ++line;
+  }
+  int y, mo, d, h, mi, s;
+  if (end - line < 19 || line[4] != '-' || line[7] != '-' || (line[10] != ' ' && line[10] != 'T') || line[13] != ':'
+      || line[16] != ':' || !digits(line, 4, y) || !digits(line + 5, 2, mo) || !digits(line + 8, 2, d)
+      || !digits(line + 11, 2, h) || !digits(line + 14, 2, mi) || !digits(line + 17, 2, s)) {
+    return no_time;
+  }
+  return days_from_civil(y, mo, d) * 86400 + h * 3600 + mi * 60 + s;
+}
+
+const char *log_input::line_start(const char *begin, const char *p) {
+  while (p != begin && p[-1] != '\n') {
+    --p;
+  }
+  return p;
+}
+
+std::string log_input::format_time(int64_t t) {
+  if (t == no_time) {
+    return "-";
+  }
+  int64_t y;
+  int m, d;
+  civil_from_days(t / 86400, y, m, d);
+  int64_t rem = t % 86400;
+  char text[32];
+  std::snprintf(text, sizeof(text), "%04lld-%02d-%02dT%02lld:%02lld:%02lld", static_cast<long long>(y), m, d,
+                static_cast<long long>(rem / 3600), static_cast<long long>(rem / 60 % 60),
+                static_cast<long long>(rem % 60));
+  return text;
+}
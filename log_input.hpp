@@ -0,0 +1,57 @@
+/*
+ * log_input.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef LOG_INPUT_HPP_
+#define LOG_INPUT_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "error_id.hpp"
+
+// what the log tools (error_scan, error_index) share: where the ids to look
+// for come from, reading log files and the timestamps starting their lines
+
+class log_input {
+public:
+  // appends the ids registered in this program
+  static void registered_ids(std::vector<error_value> &ids);
+
+  // appends the id texts of a catalog in error_catalog_gen's format, as
+  // SCOPE_ERROR builds them, and if codes is given their stable codes in the
+  // same order; false if the file cannot be read
+  static bool read_catalog(const char *path, std::vector<error_value> &ids, std::vector<uint32_t> *codes = NULL);
+
+  // appends one id text per line; false if the file cannot be read
+  static bool read_ids(const char *path, std::vector<error_value> &ids);
+
+  // a read only mapping of the whole file, NULL (with size 0) if it is
+  // empty or cannot be mapped - in which case ok is false
+  // the mapping lasts as long as the program
+  static const char *map(const char *path, size_t &size, bool &ok);
+
+  // appends [begin, end) pieces of data cut at the first line end after
+  // every chunk_bytes, so they can be scanned independently
+  static void cut(const char *data, size_t size, size_t chunk_bytes, std::vector<const char *> &pieces);
+
+  // seconds since the epoch of the timestamp starting the line
+  // ("2026-10-18 09:47:13" or "2026-10-18T09:47:13", optionally after a
+  // '['), or no_time
+  static int64_t line_time(const char *line, const char *end);
+
+  // the start of the line holding p, no earlier than begin
+  static const char *line_start(const char *begin, const char *p);
+
+  // "2026-10-18T09:47:13", or "-" for no_time
+  static std::string format_time(int64_t t);
+
+  static const int64_t no_time = -1;
+};
+
+#endif /* LOG_INPUT_HPP_ */
@@ -0,0 +1,68 @@
+/*
+ * raise_id.hpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#ifndef RAISE_ID_HPP_
+#define RAISE_ID_HPP_
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#include "error_id.hpp"
+#include "error_probe.hpp"
+
+// raising an error_id either throws it, or when the translation unit is
+// built with -fno-exceptions hands it to a handler that must not return
+// ERROR_ID_HAS_EXCEPTIONS may be defined to 0 explicitly to force the
+// latter even where exceptions are available
+#ifndef ERROR_ID_HAS_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define ERROR_ID_HAS_EXCEPTIONS 1
+#else
+#define ERROR_ID_HAS_EXCEPTIONS 0
+#endif
+#endif
+
+// the handler receives the error_id and the (NBTS) description that would
+// otherwise have been carried by the exception
+typedef void (*error_raise_handler)(error_value err, const char *what);
+
+// the default handler reports the description and aborts
+inline void error_raise_abort(error_value err, const char *what) {
+  std::fprintf(stderr, "unhandled error raised: %s\n", what ? what : err);
+  std::abort();
+}
+
+// atomic, as one thread may install a handler while others raise
+inline std::atomic<error_raise_handler> &error_raise_handler_slot() {
+  static std::atomic<error_raise_handler> handler(error_raise_abort);
+  return handler;
+}
+
+// installs a new handler, returning the previous one
+// the handler must not return: longjmp, exit or abort are all acceptable
+inline error_raise_handler set_error_raise_handler(error_raise_handler h) {
+  return error_raise_handler_slot().exchange(h ? h : error_raise_abort, std::memory_order_acq_rel);
+}
+
+inline error_raise_handler get_error_raise_handler() {
+  return error_raise_handler_slot().load(std::memory_order_acquire);
+}
+
+// raise a raw error_id value, as "throw FooErrors::eFOO2" would
+[[noreturn]] inline void raise_id(error_value err) {
+  ERROR_ID_PROBE(raise, err);
+#if ERROR_ID_HAS_EXCEPTIONS
+  throw err;
+#else
+  get_error_raise_handler()(err, err);
+  // a handler that returns leaves us nowhere sensible to go
+  std::abort();
+#endif
+}
+
+#endif /* RAISE_ID_HPP_ */
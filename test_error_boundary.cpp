@@ -0,0 +1,111 @@
+/*
+ * test_error_boundary.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+#include "LibA.h"
+
+#include "fooerrors.h"
+
+namespace {
+struct N {
+  static error_id internal;
+};
+
+const char N::internal[] = SCOPE_ERROR("GRP", "API", "internal error");
+
+bool called = false;
+
+void succeed() { called = true; }
+
+error_value return_bar() { return FooErrors::eBAR; }
+
+int return_int() { return 42; }
+
+const error_value return_const_bar() { return FooErrors::eBAR; }
+
+error_id &return_ref_por() { return FooErrors::ePOR; }
+
+const error_value foo_value = FooErrors::eFOO;
+
+error_result<int> return_failed_result() { return error_fail(FooErrors::eFOO); }
+
+error_result<std::string> return_result() { return std::string("fine"); }
+
+void throw_runtime() { throw std::runtime_error("not a typed_error"); }
+
+void throw_lite() { throw typed_error_lite<FooErrors::ePOR>(); }
+
+void throw_int() { throw 99; }
+}
+
+TEST_CASE("boundary reports success as NULL", "[boundary]") {
+
+  called = false;
+  CHECK((error_boundary<N::internal>(succeed) == NULL));
+  CHECK(called);
+
+  INFO("non error_value results are discarded");
+  CHECK((error_boundary<N::internal>(return_int) == NULL));
+}
+
+TEST_CASE("boundary passes returned error_value through", "[boundary]") {
+
+  CHECK((error_boundary<N::internal>(return_bar) == FooErrors::eBAR));
+  CHECK((error_boundary<N::internal>([] { return LibA::return_me(1); }) == LibA::eBAR));
+
+  INFO("whatever converts to error_value does too");
+  CHECK((error_boundary<N::internal>(return_const_bar) == FooErrors::eBAR));
+  CHECK((error_boundary<N::internal>(return_ref_por) == FooErrors::ePOR));
+  CHECK((error_boundary<N::internal>([]() -> const error_value & { return foo_value; }) == FooErrors::eFOO));
+}
+
+TEST_CASE("boundary passes the error of an error_result through", "[boundary]") {
+
+  CHECK((error_boundary<N::internal>(return_failed_result) == FooErrors::eFOO));
+  CHECK((error_boundary<N::internal>(return_result) == NULL));
+}
+
+TEST_CASE("boundary maps typed errors to their error_id", "[boundary]") {
+
+  CHECK((error_boundary<N::internal>([] { LibA::foo_me("FOO"); }) == LibA::eFOO));
+  CHECK((error_boundary<N::internal>([] { LibA::bar_me("BAR"); }) == LibA::eBAR));
+
+  error_value err = error_boundary<N::internal>([] { LibA::suprise_me("SURPRISE"); });
+  CHECK((err != N::internal));
+  CHECK((err != LibA::eFOO));
+  CHECK((err != LibA::eBAR));
+
+  INFO("typed_error_lite carries its error_id too");
+  CHECK((error_boundary<N::internal>(throw_lite) == FooErrors::ePOR));
+}
+
+TEST_CASE("boundary maps raw error_id throws to themselves", "[boundary]") {
+
+  CHECK((error_boundary<N::internal>(throw_eFOO) == FooErrors::eFOO));
+}
+
+TEST_CASE("boundary maps anything else to the internal error", "[boundary]") {
+
+  CHECK((error_boundary<N::internal>(throw_runtime) == N::internal));
+  CHECK((error_boundary<N::internal>(throw_int) == N::internal));
+}
+
+TEST_CASE("typed errors can be caught through their common base", "[exceptions]") {
+
+  try {
+    LibA::bar_me("BAR");
+    FAIL("should not be on this side of throw");
+  } catch (const typed_error_base &e) {
+    CHECK((e.type() == LibA::eBAR));
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ * test_error_catalog.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+
+#include "catch/catch.hpp"
+#include "error_catalog.hpp"
+#include "error_id.hpp"
+#include "error_registry.hpp"
+#include "except_id.hpp"
+
+#include "fooerrors.h"
+
+// generated from errors.tsv
+#include "GRP_CAT_errors.h"
+#include "GRP_NET_errors.h"
+
+TEST_CASE("generated error_ids match the macro", "[catalog]") {
+
+  CHECK(!strcmp(GRP_CAT::eOPEN, SCOPE_ERROR("GRP", "CAT", "Cannot open catalog")));
+  CHECK(!strcmp(GRP_NET::eTIMEOUT, "GRP-NET: Request timed out"));
+  CHECK((error_value(GRP_CAT::eOPEN) != GRP_NET::eTIMEOUT));
+
+  INFO("generated ids are full error_ids");
+  try {
+    throw typed_error<GRP_NET::eTIMEOUT>("after 30s");
+  } catch (typed_error<GRP_NET::eTIMEOUT> &e) {
+    CHECK((e.type() == GRP_NET::eTIMEOUT));
+  }
+}
+
+TEST_CASE("generated descriptors carry the metadata", "[catalog]") {
+
+  REQUIRE((GRP_NET::descriptor_count == 4));
+  const error_descriptor &timeout = GRP_NET::descriptors[0];
+  CHECK((timeout.id == GRP_NET::eTIMEOUT));
+  CHECK((timeout.severity == error_severity_error));
+  CHECK(timeout.retryable);
+  CHECK(!strcmp(timeout.name, "eTIMEOUT"));
+
+  CHECK((GRP_NET::descriptors[2].severity == error_severity_fatal));
+  CHECK(!GRP_NET::descriptors[2].retryable);
+  CHECK((GRP_NET::descriptors[3].severity == error_severity_info));
+  CHECK((GRP_CAT::descriptors[2].severity == error_severity_warning));
+}
+
+TEST_CASE("stable codes are a hash of the names, not the message", "[catalog]") {
+
+  CHECK((GRP_CAT::codes::eOPEN == error_catalog_code("GRP", "CAT", "eOPEN")));
+  CHECK((GRP_NET::codes::eTLS == error_stable_code("GRP-NET::eTLS")));
+  CHECK((GRP_CAT::codes::eOPEN != error_stable_code(GRP_CAT::eOPEN)));
+  CHECK((GRP_CAT::codes::eOPEN != GRP_CAT::codes::ePARSE));
+  // pinned in the catalog
+  CHECK((GRP_NET::codes::eSLOW == 0x00005105u));
+
+  CHECK((error_catalog::code_of(GRP_NET::eTLS) == GRP_NET::codes::eTLS));
+  CHECK((error_catalog::code_of(FooErrors::eFOO) == error_stable_code(FooErrors::eFOO)));
+}
+
+TEST_CASE("catalogued ids are registered and found both ways", "[catalog]") {
+
+  const error_descriptor *all[] = { &GRP_CAT::descriptors[0], &GRP_CAT::descriptors[1], &GRP_CAT::descriptors[2],
+                                    &GRP_NET::descriptors[0], &GRP_NET::descriptors[1], &GRP_NET::descriptors[2],
+                                    &GRP_NET::descriptors[3] };
+
+  for (unsigned i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+    INFO(all[i]->id);
+    CHECK((error_registry::index_of(all[i]->id) != 0));
+    CHECK((error_catalog::find(all[i]->id) == all[i]));
+    CHECK((error_catalog::find_code(all[i]->code) == all[i]));
+  }
+
+  INFO("uncatalogued ids and codes are not found");
+  CHECK((error_catalog::find(FooErrors::eFOO) == NULL));
+  CHECK((error_catalog::find_code(error_stable_code(FooErrors::eFOO)) == NULL));
+  CHECK((error_catalog::find(NULL) == NULL));
+}
@@ -0,0 +1,59 @@
+/*
+ * test_error_category.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <string>
+#include <system_error>
+
+#include "catch/catch.hpp"
+#include "error_category.hpp"
+#include "error_id.hpp"
+#include "error_registry.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("error_values round trip through std::error_code", "[category]") {
+  std::error_code foo = error_id_category::make(FooErrors::eFOO);
+  CHECK((bool(foo)));
+  CHECK((&foo.category() == &error_id_category::instance()));
+  CHECK((foo.value() == static_cast<int>(error_registry::index_of(FooErrors::eFOO))));
+  CHECK((error_id_category::id(foo) == FooErrors::eFOO));
+
+  std::error_code bar = error_id_category::make(FooErrors::eBAR);
+  CHECK((bar != foo));
+  CHECK((error_id_category::make(FooErrors::eFOO) == foo));
+  CHECK((error_id_category::id(bar) == FooErrors::eBAR));
+
+  // NULL is no error, either way
+  std::error_code none = error_id_category::make(NULL);
+  CHECK((!none));
+  CHECK((error_id_category::id(none) == NULL));
+  CHECK((error_id_category::id(std::error_code()) == NULL));
+}
+
+TEST_CASE("the error_id category names the id", "[category]") {
+  static error_id eLATE = SCOPE_ERROR("GRP", "CAT", "registered by make");
+
+  CHECK((error_registry::index_of(eLATE) == 0));
+  std::error_code late = error_id_category::make(eLATE);
+  CHECK((error_registry::index_of(eLATE) != 0));
+
+  CHECK((std::string(error_id_category::instance().name()) == "error_id"));
+  CHECK((late.message() == "GRP-CAT: registered by make"));
+  CHECK((error_id_category::instance().message(-1) == "unregistered error_id"));
+
+  // codes of other categories map to no error_value
+  std::error_code other = std::make_error_code(std::errc::invalid_argument);
+  CHECK((error_id_category::id(other) == NULL));
+  CHECK((error_id_category::id(std::error_code(late.value(), std::generic_category())) == NULL));
+
+  // and the code survives a std::system_error
+  try {
+    throw std::system_error(late, "opening");
+  } catch (const std::system_error &e) {
+    CHECK((error_id_category::id(e.code()) == eLATE));
+  }
+}
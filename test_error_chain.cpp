@@ -0,0 +1,129 @@
+/*
+ * test_error_chain.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+#include <memory_resource>
+
+#include "catch/catch.hpp"
+#include "error_chain.hpp"
+#include "error_id.hpp"
+
+#include "LibA.h"
+
+#include "fooerrors.h"
+
+namespace {
+// an upstream resource which counts, to show when the arena goes to it
+class counting_resource : public std::pmr::memory_resource {
+public:
+  counting_resource() : allocations(0), deallocations(0) {}
+
+  int allocations;
+  int deallocations;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+}
+
+TEST_CASE("error chain records causes outermost first", "[chain]") {
+
+  error_chain_arena<1024> arena(std::pmr::null_memory_resource());
+  error_chain chain(arena.resource());
+
+  CHECK(chain.empty());
+  CHECK((chain.id() == NULL));
+  CHECK((chain.root() == NULL));
+
+  chain.push(FooErrors::ePOR, "disk /dev/sda1");
+  chain.push(LibA::return_me(1), "reading config.ini");
+  chain.push(FooErrors::eFOO);
+
+  CHECK((chain.size() == 3));
+  CHECK((chain.id() == FooErrors::eFOO));
+  CHECK((chain.root() == FooErrors::ePOR));
+  CHECK(chain.contains(LibA::eBAR));
+  CHECK(!chain.contains(FooErrors::eBAR));
+
+  const error_cause *cause = chain.head();
+  REQUIRE(cause);
+  CHECK(!strcmp(cause->context, ""));
+  cause = cause->next;
+  REQUIRE(cause);
+  CHECK((cause->id == LibA::eBAR));
+  CHECK(!strcmp(cause->context, "reading config.ini"));
+  cause = cause->next;
+  REQUIRE(cause);
+  CHECK(!strcmp(cause->context, "disk /dev/sda1"));
+  CHECK((cause->next == NULL));
+}
+
+TEST_CASE("error chain arena reuses its buffer and frees only on reset", "[chain]") {
+
+  counting_resource upstream;
+
+  {
+    error_chain_arena<256> arena(&upstream);
+
+    for (int request = 0; request < 3; ++request) {
+      error_chain chain(arena.resource());
+      chain.push(FooErrors::eFOO, "short");
+      INFO("a chain that fits the inline buffer never reaches upstream");
+      CHECK((upstream.allocations == 0));
+      arena.reset();
+    }
+
+    int per_request = -1;
+    for (int request = 0; request < 3; ++request) {
+      int allocated = upstream.allocations;
+      int released = upstream.deallocations;
+      error_chain chain(arena.resource());
+      for (int i = 0; i < 20; ++i) {
+        chain.push(FooErrors::eBAR, "a context string long enough to overflow the inline buffer");
+      }
+      CHECK((chain.size() == 20));
+      CHECK((upstream.allocations > allocated));
+      CHECK((upstream.deallocations == released));
+      arena.reset();
+      CHECK((upstream.deallocations - released == upstream.allocations - allocated));
+
+      INFO("after reset every request starts over in the inline buffer");
+      if (per_request < 0) {
+        per_request = upstream.allocations - allocated;
+      }
+      CHECK((upstream.allocations - allocated == per_request));
+    }
+  }
+}
+
+TEST_CASE("chained_error carries the causes through a throw", "[chain]") {
+
+  error_chain_arena<512> arena;
+  error_chain chain(arena.resource());
+  chain.push(FooErrors::ePOR, "disk /dev/sda1");
+  chain.push(FooErrors::eBAR, "reading config.ini");
+
+  try {
+    throw chained_error<FooErrors::eFOO>(chain);
+  } catch (typed_error_lite<FooErrors::eFOO> &e) {
+    CHECK(!strcmp(e.what(), "reading config.ini"));
+    chained_error<FooErrors::eFOO> &chained = dynamic_cast<chained_error<FooErrors::eFOO> &>(e);
+    CHECK((chained.causes().root() == FooErrors::ePOR));
+  } catch (...) {
+    FAIL("Fell through to catch all handler");
+  }
+}
@@ -0,0 +1,105 @@
+/*
+ * test_error_channel.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_channel.hpp"
+#include "error_id.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("messages are received in order, in batches", "[channel]") {
+
+  error_channel channel(3);
+  CHECK((channel.capacity() == 4));
+
+  CHECK(channel.try_send(FooErrors::eBAR, "table orders", 10));
+  CHECK(channel.try_send(FooErrors::eFOO, NULL, 11));
+  CHECK(!channel.congested());
+  CHECK(channel.try_send(FooErrors::ePOR, "a context far longer than the forty bytes kept inline", 12));
+  CHECK(channel.congested());
+  CHECK(channel.try_send(FooErrors::eBAR, "", 13));
+
+  INFO("a full channel refuses rather than waits");
+  CHECK(!channel.try_send(FooErrors::eFOO, "dropped", 14));
+  CHECK((channel.refused() == 1));
+  CHECK((channel.size() == 4));
+
+  error_message batch[8];
+  REQUIRE((channel.receive(batch, 3) == 3));
+  CHECK((batch[0].error == FooErrors::eBAR));
+  CHECK((std::string(batch[0].context) == "table orders"));
+  CHECK((batch[0].time == 10));
+  CHECK((batch[1].error == FooErrors::eFOO));
+  CHECK((batch[1].context[0] == '\0'));
+  CHECK((std::strlen(batch[2].context) == error_message::context_size - 1));
+  CHECK((std::string(batch[2].context) == "a context far longer than the forty byt"));
+
+  INFO("the ring wraps round");
+  for (int i = 0; i < 3; ++i) {
+    CHECK(channel.try_send(FooErrors::eFOO, "again", 20 + i));
+  }
+  CHECK(!channel.try_send(FooErrors::eFOO, "dropped", 30));
+  REQUIRE((channel.receive(batch, 8) == 4));
+  CHECK((batch[0].time == 13));
+  CHECK((batch[3].time == 22));
+  CHECK(!channel.try_receive(batch[0]));
+  CHECK((channel.size() == 0));
+}
+
+TEST_CASE("many threads send to one receiver", "[channel]") {
+
+  const unsigned senders = 4;
+  const unsigned each = 20000;
+  error_channel channel(64);
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < senders; ++t) {
+    threads.push_back(std::thread([&channel, t, each]() {
+      char context[16];
+      for (unsigned i = 0; i < each; ++i) {
+        std::snprintf(context, sizeof(context), "%u", t);
+        // backpressure: wait for the supervisor to catch up
+        while (!channel.try_send(FooErrors::eBAR, context, i)) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+
+  // each sender's messages arrive in the order sent
+  std::vector<uint64_t> next(senders, 0);
+  unsigned received = 0;
+  bool ordered = true;
+  error_message batch[32];
+  while (received < senders * each) {
+    size_t n = channel.receive(batch, 32);
+    for (size_t i = 0; i < n; ++i) {
+      unsigned t = static_cast<unsigned>(std::atoi(batch[i].context));
+      ordered = ordered && t < senders && batch[i].error == FooErrors::eBAR && batch[i].time == next[t];
+      ++next[t];
+    }
+    received += static_cast<unsigned>(n);
+    if (!n) {
+      std::this_thread::yield();
+    }
+  }
+  for (unsigned t = 0; t < senders; ++t) {
+    threads[t].join();
+  }
+  CHECK(ordered);
+  CHECK((channel.size() == 0));
+  for (unsigned t = 0; t < senders; ++t) {
+    CHECK((next[t] == each));
+  }
+}
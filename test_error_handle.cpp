@@ -0,0 +1,56 @@
+/*
+ * test_error_handle.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "catch/catch.hpp"
+#include "error_handle.hpp"
+#include "error_id.hpp"
+
+// generated from errors.tsv
+#include "GRP_CAT_errors.h"
+#include "GRP_NET_errors.h"
+
+#if ERROR_ID_HAS_HANDLES
+
+namespace {
+
+ERROR_ID_SECTION error_id eLOCAL = SCOPE_ERROR("TEST", "HANDLE", "A local error");
+ERROR_ID_SECTION error_id eOTHER = SCOPE_ERROR("TEST", "HANDLE", "Another local error");
+
+}
+
+TEST_CASE("error_handle round trips an error_value", "[handle]") {
+
+  CHECK((sizeof(error_handle) == 4));
+
+  error_handle local = error_handle::of(eLOCAL);
+  CHECK((local.value() == eLOCAL));
+  CHECK((error_handle::of(eOTHER).value() == eOTHER));
+  CHECK((local != error_handle::of(eOTHER)));
+  CHECK((local == error_handle(local.offset())));
+
+  INFO("the default handle is no error, not the section's first id");
+  CHECK((error_handle().value() == NULL));
+  CHECK((error_handle::of(NULL) == error_handle()));
+  CHECK((error_handle().offset() == 0));
+  CHECK((local != error_handle()));
+
+  INFO("catalogued ids are in the same section");
+  CHECK((error_handle::of(GRP_NET::eTLS).value() == GRP_NET::eTLS));
+  CHECK((error_handle::of(GRP_CAT::eOPEN) != error_handle::of(GRP_NET::eTLS)));
+}
+
+TEST_CASE("generated error_ref tables match the descriptors", "[handle]") {
+
+  CHECK((sizeof(error_ref) == 4));
+  for (unsigned i = 0; i < GRP_NET::descriptor_count; ++i) {
+    CHECK((GRP_NET_refs[i].value() == GRP_NET::descriptors[i].id));
+    CHECK((GRP_NET_refs[i].handle() == error_handle::of(GRP_NET::descriptors[i].id)));
+  }
+  CHECK((GRP_CAT_refs[0].value() == GRP_CAT::eOPEN));
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * test_error_id_c.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// checks error_id.h from C, linked against liberrorid.a or liberrorid.so
+
+#include <stdio.h>
+#include <string.h>
+
+#include "error_id.h"
+
+static int checks = 0;
+static int failures = 0;
+
+#define C_CHECK(expr)                                                          \
+  do {                                                                         \
+    ++checks;                                                                  \
+    if (!(expr)) {                                                             \
+      ++failures;                                                              \
+      fprintf(stderr, "%s:%d: FAILED: %s\n", __FILE__, __LINE__, #expr);       \
+    }                                                                          \
+  } while (0)
+
+static error_id eOPEN = SCOPE_ERROR("GRP", "CAPI", "cannot open");
+static error_id eCLOSE = SCOPE_ERROR("GRP", "CAPI", "cannot close");
+
+static int open_table(const char *name) {
+  error_last_set(eOPEN, name);
+  return -1;
+}
+
+int main(void) {
+  struct error_id_entry records[4];
+  size_t n;
+
+  /* registry */
+  unsigned index = error_id_register(eOPEN);
+  C_CHECK(index != 0);
+  C_CHECK(error_id_register(eOPEN) == index);
+  C_CHECK(error_id_index(eOPEN) == index);
+  C_CHECK(error_id_index(eCLOSE) == 0);
+  C_CHECK(error_id_at(index) == eOPEN);
+  C_CHECK(error_id_registered() >= index);
+
+  /* stable codes, the id text hashed */
+  C_CHECK(error_id_code(eOPEN) == error_id_code("GRP-CAPI: cannot open"));
+  C_CHECK(error_id_find_code(error_id_code(eOPEN)) == eOPEN);
+  C_CHECK(error_id_find_code(error_id_code(eCLOSE)) == NULL);
+
+  /* counters register on first sight */
+  C_CHECK(error_id_counter_add(eCLOSE, 1) == 1);
+  C_CHECK(error_id_counter_add(eCLOSE, 2) == 3);
+  C_CHECK(error_id_counter_get(eCLOSE) == 3);
+  C_CHECK(error_id_counter_get(eOPEN) == 0);
+  C_CHECK(error_id_index(eCLOSE) != 0);
+  error_id_counters_reset();
+  C_CHECK(error_id_counter_get(eCLOSE) == 0);
+
+  /* the flight recorder, newest last */
+  error_id_record(eOPEN, "orders");
+  error_id_record(eCLOSE, NULL);
+  n = error_id_recorder_snapshot(records, 2);
+  C_CHECK(n == 2);
+  C_CHECK(records[0].error == eOPEN);
+  C_CHECK(!strcmp(records[0].context, "orders"));
+  C_CHECK(records[1].error == eCLOSE);
+  C_CHECK(records[1].context[0] == '\0');
+  C_CHECK(records[0].time <= records[1].time);
+  C_CHECK(records[0].thread == records[1].thread);
+  C_CHECK(error_id_recorder_dropped() == 0);
+
+  /* the last error, read inline */
+  C_CHECK(open_table("orders") == -1);
+  C_CHECK(error_id_last() == eOPEN);
+  C_CHECK(error_last_get() == eOPEN);
+  C_CHECK(!strcmp(error_last_context(), "orders"));
+  error_last_clear();
+  C_CHECK(error_id_last() == NULL);
+
+  if (failures) {
+    printf("%d of %d checks failed\n", failures, checks);
+    return 1;
+  }
+  printf("All checks passed (%d checks, C)\n", checks);
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * test_error_index.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "catch/catch.hpp"
+#include "error_index.hpp"
+
+namespace {
+std::string temporary_index() {
+  char path[] = "/tmp/error_index_XXXXXX";
+  int fd = mkstemp(path);
+  close(fd);
+  std::remove(path);
+  return path;
+}
+
+error_index_file file(uint32_t id, uint64_t begin, uint64_t end, const char *path) {
+  error_index_file f = { id, 1, 100 + id, begin, end, path };
+  return f;
+}
+
+error_posting posting(uint32_t file, uint64_t offset, int64_t time) {
+  error_posting p = { file, offset, time };
+  return p;
+}
+}
+
+TEST_CASE("index postings round trip", "[index]") {
+
+  std::string path = temporary_index();
+  {
+    error_index_reader empty(path.c_str());
+    CHECK(empty.ok());
+    CHECK((empty.segments() == 0));
+    CHECK((empty.next_file_id() == 0));
+  }
+
+  error_index_writer writer;
+  writer.add_file(file(0, 0, 5000, "app.log"));
+  writer.add_file(file(1, 0, 900, "db.log"));
+  // out of order, as threads would hand them over
+  writer.add(0xBEEF, posting(1, 40, 1000));
+  writer.add(0xBEEF, posting(0, 4000, -1));
+  writer.add(0xBEEF, posting(0, 12, 2000));
+  writer.add(0xCAFE, posting(0, 300, 1500));
+  REQUIRE(writer.append_to(path.c_str()));
+  CHECK(writer.empty());
+
+  error_index_reader reader(path.c_str());
+  REQUIRE(reader.ok());
+  CHECK((reader.segments() == 1));
+  CHECK((reader.next_file_id() == 2));
+  CHECK((reader.latest_files()[1].path == "db.log"));
+
+  std::vector<error_posting> found;
+  reader.find(0xBEEF, found);
+  REQUIRE((found.size() == 3));
+  CHECK((found[0].file == 0));
+  CHECK((found[0].offset == 12));
+  CHECK((found[0].time == 2000));
+  CHECK((found[1].offset == 4000));
+  CHECK((found[1].time == -1));
+  CHECK((found[2].file == 1));
+  CHECK((found[2].offset == 40));
+
+  error_index_code beef = reader.summary(0xBEEF);
+  CHECK((beef.count == 3));
+  CHECK((beef.first_time == 1000));
+  CHECK((reader.summary(0x1234).count == 0));
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("index appends segments and recovers from a torn append", "[index]") {
+
+  std::string path = temporary_index();
+  error_index_writer writer;
+  writer.add_file(file(0, 0, 100, "app.log"));
+  writer.add(7, posting(0, 10, 500));
+  REQUIRE(writer.append_to(path.c_str()));
+
+  // the log grew and rotated: same file id, a later range, a new name
+  writer.add_file(file(0, 100, 250, "app.log.1"));
+  writer.add(7, posting(0, 120, 400));
+  writer.add(8, posting(0, 130, 600));
+  REQUIRE(writer.append_to(path.c_str()));
+
+  // a partial segment left by a crash
+  FILE *f = std::fopen(path.c_str(), "ab");
+  std::fputs("ERRIDX", f);
+  std::fclose(f);
+
+  writer.add_file(file(1, 0, 10, "new.log"));
+  writer.add(7, posting(1, 0, 900));
+  REQUIRE(writer.append_to(path.c_str()));
+
+  {
+    error_index_reader reader(path.c_str());
+    CHECK((reader.segments() == 3));
+    CHECK((reader.files().size() == 3));
+    CHECK((reader.latest_files()[0].path == "app.log.1"));
+    CHECK((reader.summary(7).count == 3));
+    CHECK((reader.summary(7).first_time == 400));
+    std::vector<error_posting> found;
+    reader.find(7, found);
+    REQUIRE((found.size() == 3));
+    CHECK((found[1].offset == 120));
+    CHECK((found[2].file == 1));
+  }
+
+  REQUIRE(error_index_reader::compact(path.c_str()));
+  error_index_reader reader(path.c_str());
+  CHECK((reader.segments() == 1));
+  CHECK((reader.codes().size() == 2));
+  CHECK((reader.summary(7).count == 3));
+  CHECK((reader.summary(8).first_time == 600));
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("index reader keeps to the segment's bytes", "[index]") {
+
+  std::string path = temporary_index();
+  error_index_writer writer;
+  writer.add_file(file(0, 0, 100, "app.log"));
+  writer.add(7, posting(0, 10, 500));
+  writer.add(7, posting(0, 20, 600));
+  REQUIRE(writer.append_to(path.c_str()));
+
+  // the header's codes offset, and in the one code entry its count and
+  // postings offset, as laid out in error_index.cpp
+  int fd = open(path.c_str(), O_RDWR);
+  REQUIRE((fd >= 0));
+  uint64_t codes = 0;
+  REQUIRE((pread(fd, &codes, sizeof(codes), 32) == sizeof(codes)));
+  const off_t count_at = static_cast<off_t>(codes + 8);
+  const off_t postings_at = static_cast<off_t>(codes + 24);
+
+  uint64_t count = 1000000;
+  REQUIRE((pwrite(fd, &count, sizeof(count), count_at) == sizeof(count)));
+  {
+    INFO("a count past the postings stops at their end");
+    error_index_reader reader(path.c_str());
+    CHECK((reader.segments() == 1));
+    std::vector<error_posting> found;
+    reader.find(7, found);
+    REQUIRE((found.size() == 2));
+    CHECK((found[1].offset == 20));
+  }
+
+  uint64_t postings = uint64_t(1) << 40;
+  REQUIRE((pwrite(fd, &postings, sizeof(postings), postings_at) == sizeof(postings)));
+  close(fd);
+  {
+    INFO("postings outside the segment end the readable index");
+    error_index_reader reader(path.c_str());
+    CHECK(reader.ok());
+    CHECK((reader.segments() == 0));
+    std::vector<error_posting> found;
+    reader.find(7, found);
+    CHECK(found.empty());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("index writers take turns", "[index]") {
+
+  std::string path = temporary_index();
+  const int rounds = 50;
+  std::vector<std::thread> writers;
+  for (uint32_t t = 0; t < 4; ++t) {
+    writers.push_back(std::thread([&path, t]() {
+      for (int r = 0; r < rounds; ++r) {
+        error_index_writer writer;
+        writer.add_file(file(t, r * 10, r * 10 + 10, "app.log"));
+        writer.add(t, posting(t, r * 10, r));
+        writer.append_to(path.c_str());
+      }
+    }));
+  }
+
+  // compacting meanwhile loses nothing either
+  for (int c = 0; c < 5; ++c) {
+    CHECK(error_index_reader::compact(path.c_str()));
+  }
+  for (size_t t = 0; t < writers.size(); ++t) {
+    writers[t].join();
+  }
+
+  error_index_reader reader(path.c_str());
+  CHECK((reader.files().size() == 4 * rounds));
+  for (uint32_t t = 0; t < 4; ++t) {
+    CHECK((reader.summary(t).count == rounds));
+  }
+
+  std::remove(path.c_str());
+}
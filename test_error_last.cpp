@@ -0,0 +1,60 @@
+/*
+ * test_error_last.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_last.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+int open_table(const char *name) {
+  if (std::strcmp(name, "orders")) {
+    return error_last::fail(FooErrors::eBAR, name);
+  }
+  error_last::clear();
+  return 3;
+}
+}
+
+TEST_CASE("the last error and its context are kept per thread", "[last]") {
+
+  CHECK((open_table("missing") == -1));
+  CHECK((error_last::get() == FooErrors::eBAR));
+  CHECK((std::string(error_last::context()) == "missing"));
+
+  CHECK((open_table("orders") == 3));
+  CHECK((error_last::get() == NULL));
+  CHECK((error_last::context()[0] == '\0'));
+
+  error_last::set(FooErrors::eFOO, "a context much longer than the sixty four bytes that the slot keeps inline");
+  CHECK((std::strlen(error_last::context()) == error_last_slot::context_size - 1));
+
+  error_last::setf(FooErrors::ePOR, "row %d of %s", 42, "orders");
+  CHECK((std::string(error_last::context()) == "row 42 of orders"));
+
+  INFO("another thread has a slot of its own");
+  error_value other = FooErrors::eFOO;
+  std::thread([&other]() {
+    other = error_last::get();
+    error_last::set(FooErrors::eBAR);
+  }).join();
+  CHECK((other == NULL));
+  CHECK((error_last::get() == FooErrors::ePOR));
+
+  INFO("and C callers see the same slot");
+  CHECK((error_last_get() == FooErrors::ePOR));
+  error_last_set(FooErrors::eBAR, "from C");
+  CHECK((error_last::get() == FooErrors::eBAR));
+  CHECK((std::string(error_last_context()) == "from C"));
+  error_last_clear();
+  CHECK((error_last::get() == NULL));
+}
@@ -0,0 +1,85 @@
+/*
+ * test_error_latch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_latch.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("the first error set is kept", "[latch]") {
+
+  error_latch latch;
+  CHECK(!latch.should_cancel());
+  CHECK(!latch.set(NULL));
+  CHECK(!latch.should_cancel());
+  CHECK(latch.set(FooErrors::eBAR));
+  CHECK(latch.should_cancel());
+  CHECK(!latch.set(FooErrors::eFOO));
+  CHECK((latch.get() == FooErrors::eBAR));
+
+  latch.reset();
+  CHECK((latch.get() == NULL));
+  CHECK(latch.set(FooErrors::eFOO));
+}
+
+TEST_CASE("fork/join returns the first failure and stops the rest", "[latch]") {
+
+  std::atomic<unsigned> started(0);
+  error_value err = error_fork_join::run(1000, [&started](size_t i, const error_latch &) -> error_value {
+    ++started;
+    return i == 10 ? FooErrors::eFOO : NULL;
+  }, 4);
+  CHECK((err == FooErrors::eFOO));
+
+  INFO("on one thread, exactly the tasks up to the failure run");
+  started = 0;
+  err = error_fork_join::run(1000, [&started](size_t i, const error_latch &) -> error_value {
+    ++started;
+    return i == 10 ? FooErrors::eFOO : NULL;
+  }, 1);
+  CHECK((err == FooErrors::eFOO));
+  CHECK((started.load() == 11));
+
+  INFO("success when every task succeeds");
+  started = 0;
+  err = error_fork_join::run(100, [&started](size_t, const error_latch &) -> error_value {
+    ++started;
+    return NULL;
+  }, 4);
+  CHECK((err == NULL));
+  CHECK((started.load() == 100));
+
+  INFO("a running task sees the outcome decided by another");
+  std::atomic<bool> cancelled(false);
+  err = error_fork_join::run(2, [&cancelled](size_t i, const error_latch &latch) -> error_value {
+    if (i == 0) {
+      while (!latch.should_cancel()) {
+        std::this_thread::yield();
+      }
+      cancelled = true;
+      return FooErrors::eFOO;
+    }
+    return FooErrors::eBAR;
+  }, 2);
+  CHECK((err == FooErrors::eBAR));
+  CHECK(cancelled.load());
+
+  INFO("an already cancelled latch starts nothing");
+  error_latch latch;
+  latch.set(FooErrors::ePOR);
+  started = 0;
+  err = error_fork_join::run(10, [&started](size_t, const error_latch &) -> error_value {
+    ++started;
+    return NULL;
+  }, latch, 2);
+  CHECK((err == FooErrors::ePOR));
+  CHECK((started.load() == 0));
+}
@@ -0,0 +1,85 @@
+/*
+ * test_error_location.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_location.hpp"
+
+namespace {
+const char located[] = SCOPE_ERROR_LOCATION("GRP", "FOO", "Foo not Bar");
+const unsigned located_line = __LINE__ - 1;
+}
+
+TEST_CASE("SCOPE_ERROR_LOCATION text is split into its fields", "[location]") {
+
+  error_location where;
+  REQUIRE(error_location::parse(located, where));
+  CHECK((where.file == __FILE__));
+  CHECK((where.line == located_line));
+  CHECK((where.group == "GRP"));
+  CHECK((where.package == "FOO"));
+  CHECK((where.message == "Foo not Bar"));
+  INFO("the fields point into the text");
+  CHECK((where.file.data == located));
+
+  CHECK(!error_location::parse(SCOPE_ERROR("GRP", "FOO", "Foo not Bar"), where));
+  CHECK(!error_location::parse("file.cpp:42 GRP FOO: x ", where));
+  CHECK(!error_location::parse(":42 GRP-FOO: x ", where));
+  CHECK(!error_location::parse(static_cast<error_value>(NULL), where));
+}
+
+TEST_CASE("odd __FILE__ paths are kept whole", "[location]") {
+
+  error_location where;
+  const char *paths[] = { "C:\\work\\my project\\foo-bar.cpp", "/src/v2:beta/a b.cpp", "/tmp/x:1/y.cpp",
+                          "./GRP-FOO: odd.cpp" };
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+    std::string text = std::string(paths[i]) + ":1234 NET-TLS: handshake failed: 12:30 ";
+    INFO(text);
+    REQUIRE(error_location::parse(text.data(), text.size(), where));
+    CHECK((where.file.str() == paths[i]));
+    CHECK((where.line == 1234));
+    CHECK((where.group == "NET"));
+    CHECK((where.package == "TLS"));
+    CHECK((where.message == "handshake failed: 12:30"));
+  }
+
+  INFO("the first reading wins where there is more than one");
+  std::string text = "a.cpp:1 G-P: b.cpp:2 H-Q: c ";
+  REQUIRE(error_location::parse(text.data(), text.size(), where));
+  CHECK((where.file == "a.cpp"));
+  CHECK((where.message == "b.cpp:2 H-Q: c"));
+}
+
+TEST_CASE("locations are found in log lines", "[location]") {
+
+  std::string log = "2026-10-18 09:47:13 [w1] /src/foo.cpp:42 GRP-FOO: Foo not Bar \r\n"
+                    "2026-10-18 09:47:14 no location: 12 here\n"
+                    "09:47:15 (lib/a-b.cpp:7 CAT-OPEN: Cannot open)";
+  const char *end = log.data() + log.size();
+  error_location where;
+
+  const char *p = error_location::find(log.data(), end, where);
+  REQUIRE(p);
+  CHECK((*p == '\n'));
+  CHECK((where.file == "/src/foo.cpp"));
+  CHECK((where.line == 42));
+  CHECK((where.message == "Foo not Bar"));
+
+  p = error_location::find(p, end, where);
+  REQUIRE(p);
+  CHECK((p == end));
+  CHECK((where.file == "lib/a-b.cpp"));
+  CHECK((where.group == "CAT"));
+  CHECK((where.package == "OPEN"));
+  CHECK((where.message == "Cannot open)"));
+
+  CHECK(!error_location::find(p, end, where));
+}
@@ -0,0 +1,117 @@
+/*
+ * test_error_log_limit.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_log_limit.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+const uint64_t second = 1000000000ull;
+
+std::vector<std::string> lines;
+
+void collect(const char *line) { lines.push_back(line); }
+}
+
+TEST_CASE("log limiter allows a burst then the rate", "[limit]") {
+
+  error_log_limiter limiter(10, 5);
+  const uint64_t t = 100 * second;
+
+  int allowed = 0;
+  for (int i = 0; i < 100; ++i) {
+    allowed += limiter.allow(FooErrors::eBAR, t);
+  }
+  CHECK((allowed == 5));
+  CHECK((limiter.suppressed(FooErrors::eBAR) == 95));
+
+  INFO("other ids have their own bucket");
+  CHECK(limiter.allow(FooErrors::eFOO, t));
+
+  INFO("tokens return at the configured rate");
+  CHECK(limiter.allow(FooErrors::eBAR, t + second / 10));
+  CHECK(!limiter.allow(FooErrors::eBAR, t + second / 10));
+  allowed = 0;
+  for (int i = 0; i < 100; ++i) {
+    allowed += limiter.allow(FooErrors::eBAR, t + 10 * second);
+  }
+  CHECK((allowed == 5));
+}
+
+TEST_CASE("log limiter without a rate allows just the burst", "[limit]") {
+
+  error_log_limiter limiter(0, 8);
+  const uint64_t t = 100 * second;
+
+  int allowed = 0;
+  for (int i = 0; i < 100; ++i) {
+    allowed += limiter.allow(FooErrors::eBAR, t);
+  }
+  CHECK((allowed == 8));
+  for (int i = 0; i < 100; ++i) {
+    allowed += limiter.allow(FooErrors::eBAR, t + i * 1000000 * second);
+  }
+  CHECK((allowed == 8));
+  CHECK((limiter.suppressed(FooErrors::eBAR) == 192));
+
+  INFO("a rate too low to be due is the same");
+  error_log_limiter never(1e-30, 8);
+  allowed = 0;
+  for (int i = 0; i < 100; ++i) {
+    allowed += never.allow(FooErrors::eBAR, t + i * second);
+  }
+  CHECK((allowed == 8));
+
+  INFO("a low rate with a large burst does not wrap");
+  error_log_limiter slow(1e-9, 1000);
+  allowed = 0;
+  for (int i = 0; i < 2000; ++i) {
+    allowed += slow.allow(FooErrors::eBAR, t + i);
+  }
+  CHECK((allowed > 0));
+  CHECK((allowed <= 1000));
+  CHECK(!slow.allow(FooErrors::eBAR, t + 3600 * second));
+}
+
+TEST_CASE("log limiter samples suppressed occurrences", "[limit]") {
+
+  error_log_limiter limiter(1, 1, 10);
+  const uint64_t t = 200 * second;
+
+  int allowed = 0;
+  for (int i = 0; i < 101; ++i) {
+    allowed += limiter.allow(FooErrors::ePOR, t);
+  }
+  INFO("one from the bucket and one in ten of the hundred refused");
+  CHECK((allowed == 11));
+  CHECK((limiter.suppressed(FooErrors::ePOR) == 90));
+}
+
+TEST_CASE("log limiter flushes one summary line per id", "[limit]") {
+
+  error_log_limiter limiter(1, 1);
+  const uint64_t t = 300 * second;
+
+  for (int i = 0; i < 48212; ++i) {
+    limiter.allow(FooErrors::eBAR, t);
+  }
+  limiter.allow(FooErrors::eFOO, t);
+
+  lines.clear();
+  CHECK((limiter.flush(collect) == 1));
+  REQUIRE((lines.size() == 1));
+  CHECK((lines[0] == "GRP-FOO: Foo not Bar \xC3\x97" "48211 suppressed"));
+
+  INFO("flushing resets the counts");
+  CHECK((limiter.suppressed(FooErrors::eBAR) == 0));
+  CHECK((limiter.flush(collect) == 0));
+}
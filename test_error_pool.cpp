@@ -0,0 +1,188 @@
+/*
+ * test_error_pool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_pool.hpp"
+#include "error_result.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+error_result<std::string> describe(size_t i) {
+  if (i % 7 == 3) {
+    return error_fail(FooErrors::eBAR);
+  }
+  return std::string(i % 5 + 1, 'x');
+}
+
+// copies throw while fragile is set, and live counts the constructed ones
+struct brittle {
+  static int live;
+  static bool fragile;
+
+  brittle() { ++live; }
+  brittle(const brittle &) {
+    if (fragile) {
+      throw std::runtime_error("copy failed");
+    }
+    ++live;
+  }
+  ~brittle() { --live; }
+};
+
+int brittle::live = 0;
+bool brittle::fragile = false;
+
+// a divide and conquer sum, forking at every level
+error_value sum(error_pool &pool, const std::vector<long> &values, size_t begin, size_t end, long &total) {
+  if (end - begin <= 16) {
+    total = 0;
+    for (size_t i = begin; i < end; ++i) {
+      if (values[i] < 0) {
+        return FooErrors::eFOO;
+      }
+      total += values[i];
+    }
+    return NULL;
+  }
+  size_t middle = begin + (end - begin) / 2;
+  long low = 0;
+  long high = 0;
+  error_value err = pool.invoke([&]() { return sum(pool, values, begin, middle, low); },
+                                [&]() { return sum(pool, values, middle, end, high); });
+  total = low + high;
+  return err;
+}
+}
+
+TEST_CASE("error_result holds a value or the error instead", "[pool]") {
+
+  error_result<std::string> good = describe(4);
+  REQUIRE(good.ok());
+  CHECK((good.error() == NULL));
+  CHECK((good.value() == "xxxxx"));
+
+  error_result<std::string> bad = describe(3);
+  CHECK(!bad.ok());
+  CHECK((bad.error() == FooErrors::eBAR));
+
+  bad = good;
+  REQUIRE(bad.ok());
+  CHECK((bad.value() == "xxxxx"));
+  good = describe(10);
+  CHECK((good.error() == FooErrors::eBAR));
+}
+
+TEST_CASE("error_result tells values from errors that convert to them", "[pool]") {
+
+  // a text is a value, even where an error_value would convert to T
+  error_result<std::string> text = std::string("text");
+  CHECK(text.ok());
+  error_result<const char *> name = static_cast<const char *>("name");
+  REQUIRE(name.ok());
+  CHECK((std::string(name.value()) == "name"));
+  error_result<const char *> failed = error_fail(FooErrors::eFOO);
+  CHECK((failed.error() == FooErrors::eFOO));
+
+  // move-only values are moved, in and out
+  error_result<std::unique_ptr<int> > owner = std::unique_ptr<int>(new int(5));
+  error_result<std::unique_ptr<int> > taken = std::move(owner);
+  REQUIRE(taken.ok());
+  CHECK((*taken.value() == 5));
+  owner = error_fail(FooErrors::eBAR);
+  CHECK((owner.error() == FooErrors::eBAR));
+  owner = std::move(taken);
+  REQUIRE(owner.ok());
+  CHECK((*owner.value() == 5));
+}
+
+TEST_CASE("error_result is left failed when assigning its value throws", "[pool]") {
+
+  {
+    error_result<brittle> target = brittle();
+    error_result<brittle> source = brittle();
+    REQUIRE((brittle::live == 2));
+
+    brittle::fragile = true;
+    CHECK_THROWS_AS(target = source, std::runtime_error);
+    brittle::fragile = false;
+    CHECK((target.error() == error_result_lost()));
+    CHECK((brittle::live == 1));
+
+    target = source;
+    CHECK(target.ok());
+    CHECK((brittle::live == 2));
+  }
+  CHECK((brittle::live == 0));
+}
+
+TEST_CASE("fork/join on the pool propagates error_values", "[pool]") {
+
+  error_pool pool(4);
+  CHECK((pool.threads() == 4));
+
+  std::vector<long> values(10000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<long>(i);
+  }
+  long total = 0;
+  CHECK((sum(pool, values, 0, values.size(), total) == NULL));
+  CHECK((total == 10000L * 9999 / 2));
+  values[6789] = -1;
+  CHECK((sum(pool, values, 0, values.size(), total) == FooErrors::eFOO));
+
+  std::atomic<unsigned> ran(0);
+  CHECK((pool.for_each(5000, [&ran](size_t) -> error_value {
+    ++ran;
+    return NULL;
+  }, 8) == NULL));
+  CHECK((ran.load() == 5000));
+
+  INFO("a failure stops the rest of the loop");
+  ran = 0;
+  error_pool one(1);
+  CHECK((one.for_each(5000, [&ran](size_t i) -> error_value {
+    ++ran;
+    return i == 100 ? FooErrors::ePOR : NULL;
+  }) == FooErrors::ePOR));
+  CHECK((ran.load() == 101));
+  CHECK((pool.for_each(5000, [](size_t i) -> error_value { return i == 4321 ? FooErrors::ePOR : NULL; })
+         == FooErrors::ePOR));
+
+  INFO("map keeps every result");
+  std::vector<error_result<std::string> > out(1000, error_result<std::string>(std::string()));
+  CHECK((pool.map(out.size(), describe, &out[0]) == FooErrors::eBAR));
+  size_t failed = 0;
+  for (size_t i = 0; i < out.size(); ++i) {
+    if (i % 7 == 3) {
+      failed += out[i].error() == FooErrors::eBAR;
+    } else {
+      failed += !(out[i].ok() && out[i].value().size() == i % 5 + 1);
+    }
+  }
+  CHECK((failed == (1000 + 3) / 7));
+
+  INFO("map moves the results into place");
+  std::vector<error_result<std::unique_ptr<size_t> > > owned;
+  for (size_t i = 0; i < 100; ++i) {
+    owned.push_back(error_fail(FooErrors::eFOO));
+  }
+  auto own = [](size_t i) { return error_result<std::unique_ptr<size_t> >(std::unique_ptr<size_t>(new size_t(i))); };
+  CHECK((pool.map(owned.size(), own, &owned[0]) == NULL));
+  size_t wrong = 0;
+  for (size_t i = 0; i < owned.size(); ++i) {
+    wrong += !(owned[i].ok() && *owned[i].value() == i);
+  }
+  CHECK((wrong == 0));
+}
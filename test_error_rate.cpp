@@ -0,0 +1,67 @@
+/*
+ * test_error_rate.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_rate.hpp"
+#include "error_registry.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("windowed counts per error_id", "[rate]") {
+
+  error_rate_tracker tracker;
+  const uint32_t t = 1000;
+
+  for (int i = 0; i < 5; ++i) {
+    tracker.record(FooErrors::eBAR, t);
+  }
+  for (int i = 0; i < 3; ++i) {
+    tracker.record(FooErrors::eBAR, t + 5);
+  }
+  tracker.record(FooErrors::eFOO, t + 5);
+
+  CHECK((tracker.count(FooErrors::eBAR, 1, t) == 5));
+  CHECK((tracker.count(FooErrors::eBAR, 1, t + 5) == 3));
+  CHECK((tracker.count(FooErrors::eBAR, 10, t + 5) == 8));
+  CHECK((tracker.count(FooErrors::eFOO, 10, t + 5) == 1));
+  CHECK((tracker.count(FooErrors::ePOR, 10, t + 5) == 0));
+
+  INFO("the older second slides out of the window");
+  CHECK((tracker.count(FooErrors::eBAR, 5, t + 5) == 3));
+  CHECK((tracker.count(FooErrors::eBAR, 10, t + 10) == 3));
+  CHECK((tracker.count(FooErrors::eBAR, 10, t + 15) == 0));
+
+  CHECK((tracker.rate(FooErrors::eBAR, 10, t + 5) == Approx(0.8)));
+}
+
+TEST_CASE("buckets are recycled a ring later", "[rate]") {
+
+  error_rate_tracker tracker;
+  const uint32_t t = 2000;
+
+  tracker.record(FooErrors::eBAR, t);
+  tracker.record(FooErrors::eBAR, t + error_rate_tracker::buckets);
+
+  CHECK((tracker.count(FooErrors::eBAR, 1, t + error_rate_tracker::buckets) == 1));
+
+  INFO("a writer a whole ring late is not counted");
+  tracker.record(FooErrors::eBAR, t);
+  CHECK((tracker.count(FooErrors::eBAR, 1, t + error_rate_tracker::buckets) == 1));
+
+  INFO("windows are capped at max_window");
+  CHECK((tracker.count(FooErrors::eBAR, 1000, t + error_rate_tracker::buckets) == 1));
+}
+
+TEST_CASE("ids beyond capacity are ignored", "[rate]") {
+
+  error_rate_tracker tracker(1);
+  unsigned index = error_registry::add(FooErrors::ePOR);
+
+  tracker.record(FooErrors::ePOR, 10);
+  CHECK((tracker.count(FooErrors::ePOR, 1, 10) == (index <= 1 ? 1u : 0u)));
+}
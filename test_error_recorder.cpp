@@ -0,0 +1,113 @@
+/*
+ * test_error_recorder.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_counter.hpp"
+#include "error_id.hpp"
+#include "error_recorder.hpp"
+#include "error_registry.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("error counts are kept per registered id", "[counter]") {
+  static error_id eCOUNTED = SCOPE_ERROR("GRP", "CNT", "counted");
+
+  CHECK((error_counter::count(eCOUNTED) == 0));
+  CHECK((error_counter::add(eCOUNTED) == 1));
+  CHECK((error_counter::add(eCOUNTED, 4) == 5));
+  CHECK((error_counter::count(eCOUNTED) == 5));
+  CHECK((error_registry::index_of(eCOUNTED) != 0));
+  CHECK((error_counter::add(NULL) == 0));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([]() {
+      for (int i = 0; i < 10000; ++i) {
+        error_counter::add(eCOUNTED);
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  CHECK((error_counter::count(eCOUNTED) == 40005));
+
+  error_counter::reset();
+  CHECK((error_counter::count(eCOUNTED) == 0));
+}
+
+TEST_CASE("the flight recorder keeps the latest errors in order", "[recorder]") {
+  static error_record records[error_recorder::capacity];
+
+  uint64_t before = error_recorder::recorded();
+  error_recorder::record(FooErrors::eFOO, "first");
+  error_recorder::record(FooErrors::eBAR, "a context much longer than the forty bytes kept for it");
+  CHECK((error_recorder::recorded() == before + 2));
+
+  size_t n = error_recorder::snapshot(records, 2);
+  REQUIRE((n == 2));
+  CHECK((records[0].error == FooErrors::eFOO));
+  CHECK((std::string(records[0].context) == "first"));
+  CHECK((records[1].error == FooErrors::eBAR));
+  CHECK((std::strlen(records[1].context) == error_record::context_size - 1));
+  CHECK((records[0].time <= records[1].time));
+  CHECK((records[0].thread == error_recorder::thread()));
+
+  // a full ring later only the latest capacity entries remain
+  for (unsigned i = 0; i < error_recorder::capacity + 10; ++i) {
+    error_recorder::record(i % 2 ? FooErrors::eBAR : FooErrors::eFOO);
+  }
+  n = error_recorder::snapshot(records, error_recorder::capacity);
+  CHECK((n == error_recorder::capacity));
+  CHECK((records[n - 1].error == FooErrors::eBAR));
+  CHECK((records[n - 2].error == FooErrors::eFOO));
+  CHECK((records[n - 1].context[0] == '\0'));
+}
+
+TEST_CASE("the flight recorder takes entries from many threads", "[recorder]") {
+  static error_record records[error_recorder::capacity];
+  const unsigned per_thread = 2000;
+
+  uint64_t before = error_recorder::recorded();
+  uint64_t dropped = error_recorder::dropped();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([=]() {
+      for (unsigned i = 0; i < per_thread; ++i) {
+        error_recorder::record(t % 2 ? FooErrors::eBAR : FooErrors::eFOO, "worker");
+      }
+    }));
+  }
+  // a reader racing the writers sees only whole entries
+  std::vector<error_record> seen(64);
+  size_t torn = 0;
+  while (error_recorder::recorded() < before + 4 * per_thread) {
+    size_t n = error_recorder::snapshot(&seen[0], seen.size());
+    for (size_t i = 0; i < n; ++i) {
+      torn += std::string(seen[i].context) != "worker" && seen[i].context[0] != '\0';
+    }
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  CHECK((torn == 0));
+  CHECK((error_recorder::recorded() == before + 4 * per_thread));
+
+  // only the workers' entries are left
+  size_t n = error_recorder::snapshot(records, error_recorder::capacity);
+  CHECK((n + (error_recorder::dropped() - dropped) >= error_recorder::capacity));
+  size_t ours = 0;
+  for (size_t i = 0; i < n; ++i) {
+    ours += records[i].thread == error_recorder::thread();
+  }
+  CHECK((ours == 0));
+}
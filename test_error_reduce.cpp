@@ -0,0 +1,75 @@
+/*
+ * test_error_reduce.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_reduce.hpp"
+#include "error_registry.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("first and count over step results", "[reduce]") {
+
+  std::vector<error_value> results(100, NULL);
+  CHECK((error_reduce::first(&results[0], results.size()) == results.size()));
+  CHECK((error_reduce::first_error(&results[0], results.size()) == NULL));
+  CHECK((error_reduce::count(&results[0], results.size()) == 0));
+  CHECK((error_reduce::first(NULL, 0) == 0));
+
+  results[37] = FooErrors::eBAR;
+  results[38] = FooErrors::eFOO;
+  results[99] = FooErrors::eFOO;
+  CHECK((error_reduce::first(&results[0], results.size()) == 37));
+  CHECK((error_reduce::first_error(&results[0], results.size()) == FooErrors::eBAR));
+  CHECK((error_reduce::count(&results[0], results.size()) == 3));
+  CHECK((error_reduce::first(&results[0], 37) == 37));
+}
+
+TEST_CASE("reductions agree with a plain loop at every position", "[reduce]") {
+
+  // covers failures inside, across and after the vector steps
+  for (size_t n = 0; n < 70; ++n) {
+    for (size_t failed = 0; failed < n; ++failed) {
+      std::vector<error_value> results(n, NULL);
+      results[failed] = FooErrors::ePOR;
+      for (size_t i = failed + 5; i < n; i += 11) {
+        results[i] = FooErrors::eFOO;
+      }
+      size_t expected = 0;
+      for (size_t i = 0; i < n; ++i) {
+        expected += results[i] != NULL;
+      }
+      if (error_reduce::first(&results[0], n) != failed || error_reduce::count(&results[0], n) != expected) {
+        FAIL("mismatch with " << n << " results, first failure at " << failed);
+      }
+    }
+  }
+  SUCCEED("vectorised: " << error_reduce::vectorised());
+}
+
+TEST_CASE("histogram counts failures by registry index", "[reduce]") {
+
+  std::vector<error_value> results(1000, NULL);
+  for (size_t i = 3; i < results.size(); i += 10) {
+    results[i] = FooErrors::eFOO;
+  }
+  results[500] = FooErrors::eBAR;
+  results[501] = FooErrors::eBAR;
+
+  std::vector<size_t> counts;
+  error_reduce::histogram(&results[0], results.size(), counts);
+  REQUIRE((counts.size() > error_registry::index_of(FooErrors::eBAR)));
+  CHECK((counts[error_registry::index_of(FooErrors::eFOO)] == 100));
+  CHECK((counts[error_registry::index_of(FooErrors::eBAR)] == 2));
+  CHECK((counts[0] == 0));
+
+  INFO("histograms accumulate");
+  error_reduce::histogram(&results[0], results.size(), counts);
+  CHECK((counts[error_registry::index_of(FooErrors::eBAR)] == 4));
+}
@@ -0,0 +1,67 @@
+/*
+ * test_error_registry.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_registry.hpp"
+
+#include "LibA.h"
+
+#include "fooerrors.h"
+
+namespace {
+struct N {
+  static error_id new_bar;
+};
+
+const char N::new_bar[] = SCOPE_ERROR("GRP", "FOO", "Foo not Bar");
+
+error_registration reg_new_bar(N::new_bar);
+}
+
+TEST_CASE("registered ids get a dense index", "[registry]") {
+
+  unsigned foo = error_registry::add(FooErrors::eFOO);
+  unsigned bar = error_registry::add(FooErrors::eBAR);
+
+  CHECK((foo != 0));
+  CHECK((bar != 0));
+  CHECK((foo != bar));
+  CHECK((foo <= error_registry::size()));
+  CHECK((bar <= error_registry::size()));
+
+  INFO("registration is idempotent");
+  CHECK((error_registry::add(FooErrors::eFOO) == foo));
+
+  CHECK((error_registry::index_of(FooErrors::eFOO) == foo));
+  CHECK((error_registry::at(foo) == FooErrors::eFOO));
+  CHECK((error_registry::at(bar) == FooErrors::eBAR));
+}
+
+TEST_CASE("registry identity is the pointer, not the text", "[registry]") {
+
+  CHECK((reg_new_bar.index() != 0));
+  CHECK((error_registry::index_of(N::new_bar) == reg_new_bar.index()));
+
+  unsigned bar = error_registry::add(FooErrors::eBAR);
+  CHECK((bar != reg_new_bar.index()));
+
+  unsigned liba_bar = error_registry::add(LibA::return_me(1));
+  CHECK((liba_bar != bar));
+  CHECK((error_registry::at(liba_bar) == LibA::eBAR));
+}
+
+TEST_CASE("unregistered and out of range lookups", "[registry]") {
+
+  static error_id never_registered = SCOPE_ERROR("GRP", "TST", "never registered");
+
+  CHECK((error_registry::index_of(never_registered) == 0));
+  CHECK((error_registry::index_of(NULL) == 0));
+  CHECK((error_registry::add(NULL) == 0));
+  CHECK((error_registry::at(0) == NULL));
+  CHECK((error_registry::at(error_registry::size() + 1) == NULL));
+}
@@ -0,0 +1,155 @@
+/*
+ * test_error_scan.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_registry.hpp"
+#include "error_scan.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+struct found {
+  size_t end;
+  error_value id;
+};
+
+std::vector<found> scan(const error_scanner &scanner, const std::string &text) {
+  std::vector<found> all;
+  scanner.scan(text.data(), text.data() + text.size(), [&](const char *end, error_value id) {
+    found f = { static_cast<size_t>(end - text.data()), id };
+    all.push_back(f);
+  });
+  return all;
+}
+}
+
+TEST_CASE("scanner finds each id where it occurs", "[scan]") {
+
+  std::vector<error_value> ids;
+  ids.push_back(FooErrors::eFOO);
+  ids.push_back(FooErrors::eBAR);
+  error_scanner scanner(ids);
+  CHECK((scanner.patterns() == 2));
+
+  std::string log = std::string("09:00 ") + FooErrors::eBAR + "\n09:01 ok\n09:02 " + FooErrors::eFOO + " and "
+                    + FooErrors::eBAR + "\n";
+  std::vector<found> all = scan(scanner, log);
+  REQUIRE((all.size() == 3));
+  CHECK((all[0].id == FooErrors::eBAR));
+  CHECK((all[0].end == 6 + std::strlen(FooErrors::eBAR)));
+  CHECK((all[1].id == FooErrors::eFOO));
+  CHECK((all[2].id == FooErrors::eBAR));
+  CHECK((all[2].end == log.size() - 1));
+
+  CHECK((scanner.count(log.data(), log.data() + log.size()) == 3));
+  CHECK((scanner.count(log.data(), log.data() + 10) == 0));
+}
+
+TEST_CASE("overlapping and nested ids are all reported", "[scan]") {
+
+  static error_id eSHORT = "GRP-LOG: Disk";
+  static error_id eLONG = "GRP-LOG: Disk full";
+  static error_id eINNER = "full";
+  static error_id eREPEAT = "aa";
+
+  std::vector<error_value> ids;
+  ids.push_back(eSHORT);
+  ids.push_back(eLONG);
+  ids.push_back(eINNER);
+  ids.push_back(eREPEAT);
+  ids.push_back(NULL);
+  error_scanner scanner(ids);
+  CHECK((scanner.patterns() == 4));
+
+  std::vector<found> all = scan(scanner, "x GRP-LOG: Disk full");
+  REQUIRE((all.size() == 3));
+  CHECK((all[0].id == eSHORT));
+  CHECK((all[1].id == eLONG));
+  CHECK((all[2].id == eINNER));
+  CHECK((all[1].end == all[2].end));
+
+  INFO("matches may overlap themselves");
+  CHECK((scan(scanner, "aaaa").size() == 3));
+
+  INFO("the same with every state but the start sparse");
+  error_scanner sparse(ids, 0);
+  CHECK((sparse.states() == scanner.states()));
+  std::vector<found> again = scan(sparse, "x GRP-LOG: Disk full");
+  REQUIRE((again.size() == 3));
+  for (size_t i = 0; i < again.size(); ++i) {
+    CHECK((again[i].id == all[i].id));
+    CHECK((again[i].end == all[i].end));
+  }
+  CHECK((scan(sparse, "aaaa").size() == 3));
+  CHECK((scan(sparse, "GRP-LOG: Diskaa full").size() == 3));
+}
+
+TEST_CASE("a large catalog's table stays within its bound", "[scan]") {
+
+  std::vector<std::string> texts;
+  size_t text = 0;
+  for (unsigned e = 0; e < 50000; ++e) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "CORPUS-P%03u: Synthetic error %u", e % 50, e);
+    texts.push_back(buf);
+    text += texts.back().size();
+  }
+  std::vector<error_value> ids;
+  for (size_t i = 0; i < texts.size(); ++i) {
+    ids.push_back(texts[i].c_str());
+  }
+  error_scanner scanner(ids);
+  CHECK((scanner.patterns() == ids.size()));
+  // a full row per state would be hundreds of MB
+  CHECK((scanner.table_bytes() <= error_scanner::default_table_bytes + 16 * text));
+
+  // and what it finds is unchanged: "... error 49999" ends with 49, 499
+  // and 4999 in the same package
+  std::string log = "x " + texts[12345] + "\ny " + texts[49999] + "\n";
+  std::vector<found> all = scan(scanner, log);
+  REQUIRE((all.size() == 5));
+  CHECK(!std::strcmp(all[0].id, texts[12345].c_str()));
+  CHECK(!std::strcmp(all[1].id, texts[49].c_str()));
+  CHECK(!std::strcmp(all[4].id, texts[49999].c_str()));
+  CHECK((all[4].end == log.size() - 1));
+}
+
+TEST_CASE("a default scanner uses the registry", "[scan]") {
+
+  error_registry::add(FooErrors::ePOR);
+  error_scanner scanner;
+  CHECK((scanner.patterns() == error_registry::size()));
+
+  std::string log = std::string("[error] ") + FooErrors::ePOR;
+  std::vector<found> all = scan(scanner, log);
+  bool seen = false;
+  for (size_t i = 0; i < all.size(); ++i) {
+    seen = seen || (all[i].id == FooErrors::ePOR && all[i].end == log.size());
+  }
+  CHECK(seen);
+}
+
+TEST_CASE("ids are found at any offset in long text", "[scan]") {
+
+  std::vector<error_value> ids;
+  ids.push_back(FooErrors::eBAR);
+  error_scanner scanner(ids);
+
+  // the skip ahead works in 16 byte steps, so try every alignment
+  for (size_t offset = 0; offset < 40; ++offset) {
+    std::string text = std::string(offset, 'G') + FooErrors::eBAR + std::string(offset, '.');
+    std::vector<found> all = scan(scanner, text);
+    REQUIRE((all.size() == 1));
+    CHECK((all[0].end == offset + std::strlen(FooErrors::eBAR)));
+  }
+}
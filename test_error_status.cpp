@@ -0,0 +1,78 @@
+/*
+ * test_error_status.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_status.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("status column rows expand back to error_values", "[status]") {
+
+  error_status_column status(100);
+  CHECK((status.size() == 100));
+  CHECK(!status.any());
+  CHECK((status.count() == 0));
+  CHECK((status.at(3) == NULL));
+
+  CHECK(status.set(3, FooErrors::eFOO));
+  CHECK(status.set(97, FooErrors::eBAR));
+  CHECK(status.failed(3));
+  CHECK(!status.failed(4));
+  CHECK((status.at(3) == FooErrors::eFOO));
+  CHECK((status.at(97) == FooErrors::eBAR));
+  CHECK((status.index(3) == error_registry::index_of(FooErrors::eFOO)));
+
+  INFO("setting NULL marks success");
+  CHECK(status.set(97, NULL));
+  CHECK(!status.failed(97));
+}
+
+TEST_CASE("status column scans agree with a row by row check", "[status]") {
+
+  // every position within and across the vector steps, and the tail
+  const size_t sizes[] = { 0, 1, 7, 8, 9, 31, 1000, 1003 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    error_status_column status(sizes[s]);
+    std::vector<size_t> expected;
+    for (size_t row = 0; row < sizes[s]; row += 1 + row % 13) {
+      status.set(row, row % 2 ? FooErrors::eBAR : FooErrors::eFOO);
+      expected.push_back(row);
+    }
+
+    CHECK((status.any() == !expected.empty()));
+    CHECK((status.count() == expected.size()));
+
+    std::vector<size_t> seen;
+    bool values_match = true;
+    status.for_each_error([&](size_t row, error_value err) {
+      seen.push_back(row);
+      values_match = values_match && err == (row % 2 ? FooErrors::eBAR : FooErrors::eFOO);
+    });
+    CHECK((seen == expected));
+    CHECK(values_match);
+
+    status.clear_all();
+    CHECK(!status.any());
+    CHECK((status.next_error(0) == status.size()));
+  }
+}
+
+TEST_CASE("a single failure is found anywhere in the column", "[status]") {
+
+  error_status_column status(40);
+  for (size_t row = 0; row < status.size(); ++row) {
+    status.set(row, FooErrors::ePOR);
+    CHECK(status.any());
+    CHECK((status.count() == 1));
+    CHECK((status.next_error(0) == row));
+    CHECK((status.next_error(row + 1) == status.size()));
+    status.clear(row);
+  }
+}
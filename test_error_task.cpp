@@ -0,0 +1,166 @@
+/*
+ * test_error_task.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <coroutine>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_result.hpp"
+#include "error_task.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+int alive = 0;
+int reached = 0;
+
+// counts the frames whose locals are still alive
+struct frame_guard {
+  frame_guard() { ++alive; }
+  ~frame_guard() { --alive; }
+};
+
+error_result<int> parse(const char *text) {
+  if (!*text) {
+    return error_fail(FooErrors::eBAR);
+  }
+  return static_cast<int>(std::string(text).size());
+}
+
+error_task<int> leaf(const char *text) {
+  frame_guard guard;
+  int n = co_await parse(text);
+  ++reached;
+  co_return n * 10;
+}
+
+error_task<int> middle(const char *text) {
+  frame_guard guard;
+  int n = co_await leaf(text);
+  ++reached;
+  co_await (n < 100 ? NULL : FooErrors::eFOO);
+  co_return n + 1;
+}
+
+error_task<std::string> outer(const char *text) {
+  frame_guard guard;
+  int n = co_await middle(text);
+  ++reached;
+  co_return std::to_string(n);
+}
+
+error_task<void> checked(const char *text) {
+  error_result<int> lvalue = parse(text);
+  co_await lvalue;
+  co_return;
+}
+
+error_task<int> fallback(const char *text) {
+  error_result<int> n = co_await leaf(text).outcome();
+  co_return n.ok() ? n.value() : -1;
+}
+
+error_task<int> explicit_error() { co_return error_fail(FooErrors::ePOR); }
+
+error_task<int> suspends() {
+  co_await std::suspend_always();
+  co_return 7;
+}
+}
+
+TEST_CASE("error_task results pass through co_await", "[task]") {
+
+  reached = 0;
+  error_result<std::string> r = outer("abc").run();
+  REQUIRE(r.ok());
+  CHECK((r.value() == "31"));
+  CHECK((reached == 3));
+  CHECK((alive == 0));
+
+  CHECK((checked("x").run() == NULL));
+  CHECK((explicit_error().run().error() == FooErrors::ePOR));
+}
+
+TEST_CASE("outcome() leaves the value in the task", "[task]") {
+
+  error_task<std::string> task = outer("abcdef");
+  task.start();
+  REQUIRE(task.done());
+  error_result<std::string> first = task.outcome();
+  error_result<std::string> second = task.outcome();
+  REQUIRE(first.ok());
+  REQUIRE(second.ok());
+  CHECK((first.value() == "61"));
+  CHECK((second.value() == "61"));
+}
+
+TEST_CASE("an error completes every awaiting task at once", "[task]") {
+
+  reached = 0;
+  {
+    error_task<std::string> task = outer("");
+    task.start();
+    REQUIRE(task.done());
+    CHECK((task.outcome().error() == FooErrors::eBAR));
+    INFO("nothing after the failing co_await ran");
+    CHECK((reached == 0));
+    INFO("the frames wait, suspended, for their owner");
+    CHECK((alive == 3));
+  }
+  CHECK((alive == 0));
+
+  reached = 0;
+  CHECK((outer("0123456789").run().error() == FooErrors::eFOO));
+  CHECK((reached == 2));
+  CHECK((alive == 0));
+
+  CHECK((checked("").run() == FooErrors::eBAR));
+
+  INFO("outcome() hands the failure to the caller instead");
+  CHECK((fallback("").run().value() == -1));
+  CHECK((fallback("ab").run().value() == 20));
+}
+
+TEST_CASE("error_task awaits other awaitables", "[task]") {
+
+  error_task<int> task = suspends();
+  task.start();
+  CHECK(!task.done());
+  task.start();
+  REQUIRE(task.done());
+  CHECK((task.outcome().value() == 7));
+}
+
+TEST_CASE("coroutine frames are recycled", "[task]") {
+
+  void *first = error_frame_pool::allocate(200);
+  error_frame_pool::deallocate(first, 200);
+  void *second = error_frame_pool::allocate(250);
+  CHECK((first == second));
+  error_frame_pool::deallocate(second, 250);
+
+  void *large = error_frame_pool::allocate(error_frame_pool::classes * error_frame_pool::granule + 1);
+  error_frame_pool::deallocate(large, error_frame_pool::classes * error_frame_pool::granule + 1);
+}
+
+TEST_CASE("coroutine frame lists are capped", "[task]") {
+
+  const std::size_t bytes = 100;
+  std::size_t before = error_frame_pool::kept(bytes);
+  std::vector<void *> frames;
+  for (std::size_t i = 0; i < before + error_frame_pool::cached + 8; ++i) {
+    frames.push_back(error_frame_pool::allocate(bytes));
+  }
+  CHECK((error_frame_pool::kept(bytes) == 0));
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    error_frame_pool::deallocate(frames[i], bytes);
+  }
+  INFO("frames past the cap go back to the heap");
+  CHECK((error_frame_pool::kept(bytes) == error_frame_pool::cached));
+}
@@ -0,0 +1,110 @@
+/*
+ * test_except_fmt.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstring>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "except_fmt.hpp"
+
+#include "fooerrors.h"
+
+TEST_CASE("lazily formatted error carries its error_id", "[exceptions]") {
+
+  typed_error_fmt<FooErrors::eFOO, int> err("rc %d", 42);
+
+  CHECK((err.type() == FooErrors::eFOO));
+  CHECK((err.type() != FooErrors::eBAR));
+  CHECK(!strcmp(err.format_string(), "rc %d"));
+}
+
+TEST_CASE("lazily formatted error formats on what()", "[exceptions]") {
+
+  std::string name = "config.ini";
+  typed_error_fmt<FooErrors::eBAR, std::string, int> err("cannot open %s (%d)", name, 2);
+
+  // the captured copy is independent of the original argument
+  name = "clobbered";
+
+  CHECK(!strcmp(err.what(), "cannot open config.ini (2)"));
+  INFO("the formatted text is cached");
+  CHECK((err.what() == err.what()));
+}
+
+TEST_CASE("lazily formatted error copies string arguments", "[exceptions]") {
+
+  char buf[32] = "key-1";
+  typed_error_fmt<FooErrors::eBAR, const char *> err("missing %s", buf);
+  strcpy(buf, "key-2");
+
+  CHECK(!strcmp(err.what(), "missing key-1"));
+
+  INFO("over-long strings are truncated, marked with ..., rather than overflowing");
+  std::string long_key(ERROR_ID_FMT_CONTEXT * 2, 'k');
+  typed_error_fmt<FooErrors::eBAR, std::string> truncated("%s", long_key);
+  CHECK((strlen(truncated.what()) == ERROR_ID_FMT_CONTEXT - 1));
+  CHECK((std::string(truncated.what()) == long_key.substr(0, ERROR_ID_FMT_CONTEXT - 4) + "..."));
+
+  std::string exact_key(ERROR_ID_FMT_CONTEXT - 1, 'k');
+  typed_error_fmt<FooErrors::eBAR, std::string> kept("%s", exact_key);
+  CHECK((kept.what() == exact_key));
+}
+
+TEST_CASE("lazily formatted error without arguments", "[exceptions]") {
+
+  typed_error_fmt<FooErrors::ePOR> err("100% literal");
+  CHECK(!strcmp(err.what(), "100% literal"));
+}
+
+TEST_CASE("lazily formatted error arguments are checked", "[exceptions]") {
+
+  static_assert(fmt_printable<int>::value && fmt_printable<double>::value && fmt_printable<const void *>::value
+                    && fmt_printable<fmt_context_str>::value,
+                "printf arguments");
+  static_assert(!fmt_printable<std::string>::value, "class types cannot go through varargs");
+
+  std::string name = "config.ini";
+  typed_error_fmt<FooErrors::eBAR, const char *, int> err =
+      TYPED_ERROR_FMT(FooErrors::eBAR, "cannot open %s (%d)", name.c_str(), 2);
+  CHECK((err.type() == FooErrors::eBAR));
+  CHECK(!strcmp(err.what(), "cannot open config.ini (2)"));
+}
+
+TEST_CASE("throw and catch lazily formatted errors", "[exceptions]") {
+
+  SECTION("caught by the lite handler for the same error_id") {
+    try {
+      throw make_typed_error<FooErrors::eFOO>("cannot open %s (%d)", "foo.txt", 13);
+    } catch (typed_error<FooErrors::eFOO> &e) {
+      FAIL("caught in typed_error handler");
+    } catch (typed_error_lite<FooErrors::eFOO> &e) {
+      CHECK((e.type() == FooErrors::eFOO));
+      CHECK(!strcmp(e.what(), "cannot open foo.txt (13)"));
+    } catch (...) {
+      FAIL("Fell through to catch all handler");
+    }
+  }
+
+  SECTION("caught by the common base") {
+    try {
+      throw make_typed_error<FooErrors::eBAR>("retry %u", 3u);
+    } catch (typed_error_base &e) {
+      CHECK((e.type() == FooErrors::eBAR));
+    } catch (...) {
+      FAIL("Fell through to catch all handler");
+    }
+  }
+
+  SECTION("caught as std::exception") {
+    try {
+      throw make_typed_error<FooErrors::eBAR>("retry %u", 3u);
+    } catch (std::exception &e) {
+      CHECK(!strcmp(e.what(), "retry 3"));
+    }
+  }
+}
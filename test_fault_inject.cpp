@@ -0,0 +1,124 @@
+/*
+ * test_fault_inject.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <string>
+
+#include "catch/catch.hpp"
+#include "error_id.hpp"
+#include "error_registry.hpp"
+#include "fault_inject.hpp"
+
+#include "fooerrors.h"
+
+namespace {
+error_value guarded_work() {
+  if (error_value err = ERROR_ID_INJECT("test.guarded_work")) {
+    return err;
+  }
+  return NULL;
+}
+
+error_value other_work() {
+  if (error_value err = ERROR_ID_INJECT("test.other_work")) {
+    return err;
+  }
+  return NULL;
+}
+}
+
+TEST_CASE("injection points report nothing while disabled", "[inject]") {
+
+  fault_injection::disarm_all();
+  fault_injection::arm("test.guarded_work", FooErrors::ePOR);
+  fault_injection::disable();
+
+  CHECK((guarded_work() == NULL));
+  CHECK((fault_injection::fired("test.guarded_work") == 0));
+}
+
+TEST_CASE("armed injection points report their error_id", "[inject]") {
+
+  fault_injection::disarm_all();
+  fault_injection::arm("test.guarded_work", FooErrors::ePOR);
+  fault_injection::enable();
+
+  uint64_t before = fault_injection::fired("test.guarded_work");
+  CHECK((guarded_work() == FooErrors::ePOR));
+  CHECK((guarded_work() == FooErrors::ePOR));
+  CHECK((fault_injection::fired("test.guarded_work") == before + 2));
+
+  INFO("other sites are unaffected");
+  CHECK((other_work() == NULL));
+
+  fault_injection::disarm("test.guarded_work");
+  CHECK((guarded_work() == NULL));
+
+  fault_injection::disable();
+}
+
+TEST_CASE("injection sites are told apart by their whole name", "[inject]") {
+
+  fault_injection::disarm_all();
+  std::string prefix(fault_injection::max_name - 1, 's');
+  std::string first = prefix + "1";
+  std::string second = prefix + "2";
+
+  INFO("names too long to keep whole are refused");
+  CHECK(!fault_injection::arm(first.c_str(), FooErrors::ePOR));
+  CHECK((fault_injection::fired(second.c_str()) == 0));
+  fault_injection::enable();
+  fault_injection::site site(second.c_str());
+  CHECK((site.fire() == NULL));
+
+  INFO("names differing in their last byte are distinct");
+  std::string third = prefix.substr(1) + "3";
+  std::string fourth = prefix.substr(1) + "4";
+  CHECK(fault_injection::arm(third.c_str(), FooErrors::ePOR));
+  fault_injection::site site_third(third.c_str());
+  fault_injection::site site_fourth(fourth.c_str());
+  CHECK((site_third.fire() == FooErrors::ePOR));
+  CHECK((site_fourth.fire() == NULL));
+
+  fault_injection::disarm_all();
+  fault_injection::disable();
+}
+
+TEST_CASE("injection probability is honoured", "[inject]") {
+
+  fault_injection::disarm_all();
+  fault_injection::arm("test.other_work", FooErrors::eBAR, 0.25);
+  fault_injection::enable();
+
+  int failures = 0;
+  for (int i = 0; i < 10000; ++i) {
+    failures += (other_work() == FooErrors::eBAR);
+  }
+  CHECK((failures > 2000));
+  CHECK((failures < 3000));
+
+  fault_injection::arm("test.other_work", FooErrors::eBAR, 0.0);
+  CHECK((other_work() == NULL));
+
+  fault_injection::disarm_all();
+  fault_injection::disable();
+}
+
+TEST_CASE("injection configured from text", "[inject]") {
+
+  fault_injection::disarm_all();
+  fault_injection::disable();
+  error_registry::add(FooErrors::ePOR);
+
+  CHECK((fault_injection::configure("test.guarded_work=1:GRP-FOO: Foo not reparable;"
+                                    "test.other_work=1:GRP-TST: not a registered id") == 1));
+  CHECK(fault_injection::active.load());
+  CHECK((guarded_work() == FooErrors::ePOR));
+  CHECK((other_work() == NULL));
+
+  fault_injection::disarm_all();
+  fault_injection::disable();
+}
@@ -0,0 +1,80 @@
+/*
+ * test_log_input.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "catch/catch.hpp"
+#include "error_catalog.hpp"
+#include "error_id.hpp"
+#include "log_input.hpp"
+
+TEST_CASE("line timestamps are read in either form", "[log]") {
+
+  const char *line = "2026-10-18 09:47:13 [w1] GRP-NET: Request timed out";
+  int64_t t = log_input::line_time(line, line + std::strlen(line));
+  CHECK((log_input::format_time(t) == "2026-10-18T09:47:13"));
+
+  const char *iso = "[2026-10-18T09:47:13Z] started";
+  CHECK((log_input::line_time(iso, iso + std::strlen(iso)) == t));
+
+  const char *early = "1970-01-02 00:00:01";
+  CHECK((log_input::line_time(early, early + std::strlen(early)) == 86401));
+
+  const char *none = "GRP-NET: Request timed out at 2026-10-18 09:47:13";
+  CHECK((log_input::line_time(none, none + std::strlen(none)) == log_input::no_time));
+  CHECK((log_input::line_time(line, line + 10) == log_input::no_time));
+  CHECK((log_input::format_time(log_input::no_time) == "-"));
+}
+
+TEST_CASE("logs are cut at line ends", "[log]") {
+
+  std::string text = "one\ntwo\nthree\nfour";
+  std::vector<const char *> pieces;
+  log_input::cut(text.data(), text.size(), 5, pieces);
+  REQUIRE((pieces.size() == 6));
+  CHECK((std::string(pieces[0], pieces[1]) == "one\ntwo\n"));
+  CHECK((std::string(pieces[2], pieces[3]) == "three\n"));
+  CHECK((std::string(pieces[4], pieces[5]) == "four"));
+
+  CHECK((log_input::line_start(text.data(), text.data() + 10) == text.data() + 8));
+  CHECK((log_input::line_start(text.data(), text.data() + 2) == text.data()));
+}
+
+TEST_CASE("catalogs are read as error_catalog_gen reads them", "[log]") {
+
+  char path[] = "/tmp/log_input_catalog_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE((fd >= 0));
+  close(fd);
+  FILE *f = std::fopen(path, "w");
+  std::fputs("# group\tpackage\tname\tmessage\n"
+             "\n"
+             "GRP\tCAT\teOPEN\tCannot open catalog\r\n"
+             "GRP\tCAT\teREAD\tCannot read catalog\terror\tno\t0x10\n"
+             "GRP\tCAT\teBAD\tCode out of range\terror\tno\t-1\n"
+             "GRP\tCAT\teSHORT\n",
+             f);
+  std::fclose(f);
+
+  std::vector<error_value> ids;
+  std::vector<uint32_t> codes;
+  REQUIRE(log_input::read_catalog(path, ids, &codes));
+  std::remove(path);
+
+  REQUIRE((ids.size() == 2));
+  REQUIRE((codes.size() == 2));
+  CHECK((std::string(ids[0]) == "GRP-CAT: Cannot open catalog"));
+  CHECK((codes[0] == error_catalog_code("GRP", "CAT", "eOPEN")));
+  CHECK((std::string(ids[1]) == "GRP-CAT: Cannot read catalog"));
+  CHECK((codes[1] == 0x10));
+}
@@ -0,0 +1,102 @@
+/*
+ * test_noexcept.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: patrick
+ */
+
+// CATCH needs exceptions, so the -fno-exceptions build carries its own
+// minimal driver: raised errors are recovered via a longjmp handler
+
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+
+#include "error_id.hpp"
+#include "except_id.hpp"
+
+#include "LibA.h"
+
+#include "fooerrors.h"
+
+namespace {
+
+int checks = 0;
+int failures = 0;
+
+#define NOEXCEPT_CHECK(expr)                                                   \
+  do {                                                                         \
+    ++checks;                                                                  \
+    if (!(expr)) {                                                             \
+      ++failures;                                                              \
+      std::fprintf(stderr, "%s:%d: FAILED: %s\n", __FILE__, __LINE__, #expr);  \
+    }                                                                          \
+  } while (0)
+
+std::jmp_buf raise_point;
+error_value raised_err = NULL;
+const char *raised_what = NULL;
+
+void longjmp_handler(error_value err, const char *what) {
+  raised_err = err;
+  raised_what = what;
+  std::longjmp(raise_point, 1);
+}
+
+// runs the raising function, returning the error_id handed to the handler
+error_value capture(void (*fn)(const char *), const char *message) {
+  raised_err = NULL;
+  raised_what = NULL;
+  if (setjmp(raise_point) == 0) {
+    fn(message);
+  }
+  return raised_err;
+}
+
+void call_throw_eFOO(const char *) { throw_eFOO(); }
+
+void raise_bar(const char *message) { raise_typed<FooErrors::eBAR>(message); }
+
+}
+
+int main() {
+
+  NOEXCEPT_CHECK(!ERROR_ID_HAS_EXCEPTIONS);
+
+  // returned values are unaffected by the build mode
+  NOEXCEPT_CHECK(LibA::return_me(0) == LibA::eFOO);
+  NOEXCEPT_CHECK(LibA::return_me(1) == LibA::eBAR);
+  NOEXCEPT_CHECK(LibA::return_me(-1) != LibA::eFOO);
+
+  // the typed_error instances can still be constructed and inspected
+  typed_error<LibA::eFOO> foo = LibA::get_foo("FOO");
+  NOEXCEPT_CHECK(foo.type() == LibA::eFOO);
+  NOEXCEPT_CHECK(!std::strcmp(foo.what(), "FOO"));
+
+  error_raise_handler previous = set_error_raise_handler(longjmp_handler);
+  NOEXCEPT_CHECK(previous == error_raise_abort);
+
+  // raising helpers divert to the handler instead of throwing
+  NOEXCEPT_CHECK(capture(LibA::foo_me, "FOO") == LibA::eFOO);
+  NOEXCEPT_CHECK(!std::strcmp(raised_what, "FOO"));
+
+  NOEXCEPT_CHECK(capture(LibA::bar_me, "BAR") == LibA::eBAR);
+  NOEXCEPT_CHECK(capture(LibA::suprise_me, "SURPRISE") != LibA::eBAR);
+  NOEXCEPT_CHECK(!std::strcmp(raised_what, "SURPRISE"));
+
+  NOEXCEPT_CHECK(capture(call_throw_eFOO, NULL) == FooErrors::eFOO);
+  NOEXCEPT_CHECK(raised_what == FooErrors::eFOO);
+
+  NOEXCEPT_CHECK(capture(raise_bar, "bazong") == FooErrors::eBAR);
+  NOEXCEPT_CHECK(capture(raise_bar, "bazong") != FooErrors::eFOO);
+
+  set_error_raise_handler(NULL);
+  NOEXCEPT_CHECK(get_error_raise_handler() == error_raise_abort);
+
+  if (failures) {
+    std::printf("%d of %d checks failed\n", failures, checks);
+    return 1;
+  }
+  std::printf("All checks passed (%d checks, -fno-exceptions)\n", checks);
+  return 0;
+}
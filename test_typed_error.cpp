@@ -190,6 +190,27 @@ TEST_CASE("ensure throwing exception instances works", "[exceptions]") {
   }
 }
 
+TEST_CASE("cached exception_ptr for typed_error_lite", "[exceptions]") {
+
+  std::exception_ptr foo = lite_exception_ptr<FooErrors::eFOO>();
+
+  INFO("the same instance is handed out every time");
+  CHECK((foo == lite_exception_ptr<FooErrors::eFOO>()));
+  CHECK((foo != lite_exception_ptr<FooErrors::eBAR>()));
+
+  for (int waiter = 0; waiter < 2; ++waiter) {
+    try {
+      std::rethrow_exception(foo);
+    } catch (typed_error<FooErrors::eFOO> &e) {
+      FAIL("caught in foo_err handler");
+    } catch (typed_error_lite<FooErrors::eFOO> &e) {
+      CHECK((e.type() == FooErrors::eFOO));
+    } catch (...) {
+      FAIL("Fell through to catch all handler");
+    }
+  }
+}
+
 TEST_CASE("ensure handling thrown exception instances works", "[exceptions]") {
 
   // check specific exception handling